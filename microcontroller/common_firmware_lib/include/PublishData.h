@@ -39,10 +39,64 @@ struct PublishData {
           sourceActuator(nullptr), sourceSensor(sensor) {}
     
     // Constructor for general data (status, errors, etc.)
-    PublishData(const char* topic, const char* uuid, const String& value, 
+    PublishData(const char* topic, const char* uuid, const String& value,
                 const String& timestamp)
         : topic(topic), uuid(uuid), serializedValue(value), timestampIsoUtc(timestamp),
           sourceActuator(nullptr), sourceSensor(nullptr) {}
 };
 
+// =============================================================================
+// Batched sensor publishing (opt-in)
+// =============================================================================
+
+// Opt-in batched payload format: define ENABLE_BATCHED_SENSOR_PUBLISH=1 (plus
+// SENSOR_BATCH_TOPIC) in the controller's build_flags to publish one MQTT
+// message per sensor read - an array of {uuid, value} entries sharing a single
+// timestamp_utc - instead of one message per reading. Cuts message volume ~3x
+// for multi-reading sensors like the BME280.
+#ifndef ENABLE_BATCHED_SENSOR_PUBLISH
+#define ENABLE_BATCHED_SENSOR_PUBLISH 0
+#endif
+
+// Max readings one sensor read can produce (BME280/SCD4x produce 3; headroom for one more)
+#define PUBLISH_BATCH_MAX_READINGS 4
+
+/**
+ * One {uuid, value} entry inside a batched payload
+ */
+struct BatchReadingEntry {
+    const char* uuid;
+    String serializedValue;
+};
+
+/**
+ * BatchPublishData Struct
+ *
+ * Purpose: Represents one batched publish - all readings from a single sensor
+ * read, sharing one timestamp. Published as:
+ * {"timestamp_utc": "...", "readings": [{"uuid": "...", "value": "..."}, ...]}
+ */
+struct BatchPublishData {
+    const char* topic;              // Batch topic to publish to (SENSOR_BATCH_TOPIC)
+    String timestampIsoUtc;         // Shared timestamp for all entries
+    BatchReadingEntry entries[PUBLISH_BATCH_MAX_READINGS];
+    size_t entryCount;
+    SensorPoint* sourceSensor;      // Sensor whose read produced this batch
+
+    BatchPublishData() : topic(nullptr), entryCount(0), sourceSensor(nullptr) {}
+
+    BatchPublishData(const char* topic, const String& timestamp, SensorPoint* sensor)
+        : topic(topic), timestampIsoUtc(timestamp), entryCount(0), sourceSensor(sensor) {}
+
+    // Add an entry; silently drops past PUBLISH_BATCH_MAX_READINGS
+    // (callers batch one sensor's readings, which always fit)
+    void addEntry(const char* uuid, const String& value) {
+        if (entryCount < PUBLISH_BATCH_MAX_READINGS) {
+            entries[entryCount].uuid = uuid;
+            entries[entryCount].serializedValue = value;
+            entryCount++;
+        }
+    }
+};
+
 #endif // PUBLISH_DATA_H 
\ No newline at end of file
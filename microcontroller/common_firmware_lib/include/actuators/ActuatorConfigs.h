@@ -30,6 +30,8 @@ struct ActuatorConfig {
     const char* readback_uuid;          // UUID for readback/status publishing
     unsigned long republish_frequency_ms; // How often to republish status
     unsigned long max_time_no_publish_ms; // Timeout for publish failure detection
+    uint8_t critical_fast_path;         // 1 = execute validated on/off commands at MQTT callback time (0 = normal FSM path)
+    unsigned long cov_heartbeat_ms;     // CoV mode: republish unchanged readback only this often (0 = legacy republish_frequency_ms)
 };
 
 
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "ActuatorConfigs.h"  // For ActuatorConfig struct
+#include "../utils/IntrusiveUniqueQueue.h"  // Queue-membership mixin
 
 /**
  * ActuatorControlPoint Class
@@ -14,7 +15,7 @@
  * Based on ADR-22 Section 2.2.1 (Modified for FSM-centric state management)
  * Updated for ADR-25 struct-based configuration
  */
-class ActuatorControlPoint {
+class ActuatorControlPoint : public IntrusiveQueueMember {
 private:
     // Configuration members (from ActuatorConfig struct)
     int _pin;
@@ -28,12 +29,28 @@ private:
     // Timing configuration
     unsigned long _outputRepublishFrequencyMillis;
     unsigned long _maxTimeNoPublishMillis;
+    unsigned long _covHeartbeatMillis;   // CoV mode: slow heartbeat instead of the periodic republish (0 = legacy)
     
     // FSM-managed timestamps (no hardware state stored here)
     unsigned long _lastPublishTimeMillis;        // Set by FSM after confirmed publish of readback
     
-    // Last successful payload for periodic republishing (logging only, not control logic)
-    String _lastSuccessfulPayload;              // Set only in executeDeviceCommand() on success
+    // Last successful payload for periodic republishing ("on"/"off"). Fixed
+    // buffer (not a String) so the fast path can write it from the network
+    // core while the FSM core reads it - no heap reallocation to race on.
+    char _lastSuccessfulPayload[8];
+
+    // Pending command storage for the intrusive command queue ("on"/"off";
+    // latest wins - ThreadSafeCommandQueue overwrites it in place)
+    char _pendingCommand[8];
+    friend class ThreadSafeCommandQueue;
+
+    // Fast-path configuration and end-to-end latency instrumentation
+    bool _criticalFastPath;                      // Execute at callback time (config.critical_fast_path)
+    volatile bool _fastPathReadbackPending;      // Set by the callback, drained by the FSM
+    volatile unsigned long _commandReceiptUs;    // micros() at MQTT callback receipt
+    uint32_t _commandLatencyCount;               // Executed commands with latency recorded
+    uint32_t _commandLatencyMaxUs;               // Worst receipt->digitalWrite latency
+    uint64_t _commandLatencyTotalUs;             // Sum for the average
     
 public:
     /**
@@ -104,6 +121,33 @@ public:
     bool isLastStateSet() const;                 // Returns true if _lastSuccessfulPayload is not empty
     String getLastSuccessfulPayload() const;     // Returns the last successful payload ("on" or "off")
     void setLastSuccessfulPayload(const String& payload);  // Sets the last successful payload
+
+    // === Command fast path and latency instrumentation ===
+
+    // True if validated commands for this actuator execute at callback time
+    bool isCriticalFastPath() const;
+
+    // Readback-pending handoff: the callback executes the command and sets
+    // this; the FSM queues the readback publish and clears it
+    void setFastPathReadbackPending(bool pending);
+    bool hasFastPathReadbackPending() const;
+
+    /**
+     * Stamp command receipt (called by the MQTT callback before queueing
+     * or executing). recordCommandExecuted() measures against this.
+     */
+    void markCommandReceived();
+
+    /**
+     * Record receipt->digitalWrite latency for the command just executed.
+     * Call right after a successful executeDeviceCommand().
+     */
+    void recordCommandExecuted();
+
+    // Latency distribution accessors (for the diagnostics publish)
+    uint32_t getCommandLatencyCount() const;
+    uint32_t getCommandLatencyAvgUs() const;
+    uint32_t getCommandLatencyMaxUs() const;
 };
 
 #endif // ACTUATOR_CONTROL_POINT_H 
\ No newline at end of file
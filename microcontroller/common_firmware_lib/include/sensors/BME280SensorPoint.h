@@ -3,6 +3,7 @@
 
 #include "SensorPoint.h"
 #include "SensorReadTimes.h"
+#include "../utils/Log.h"
 #include "SensorConfigs.h"  // For BME280Config struct (now in same directory)
 #include <Adafruit_BME280.h>
 
@@ -21,16 +22,15 @@ private:
     const char* _pressureTopic;
     const char* _pressureUUID;
     
-    // Last successful readings with timestamp
+    // Last successful readings (timestamp lives in the SensorPoint base)
     float _lastTemperatureC;
     float _lastHumidity;
     float _lastPressurePa;  // Pressure in Pascals
-    String _lastReadTimestamp;  // Timestamp when reading was taken
     bool _hasValidReading;
     
 public:
     BME280SensorPoint(const BME280Config& config)
-        : SensorPoint(BME280_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name)
+        : SensorPoint(BME280_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name, config.sample_interval_ms, config.cov_deadband, config.cov_heartbeat_ms)
         , _i2cAddress(config.address)
         , _convertToFahrenheit(config.c_to_f)
         , _temperatureTopic(config.temp_topic)
@@ -46,15 +46,10 @@ public:
     
     bool initialize() override {
         if (!_bme280.begin(_i2cAddress)) {
-            Serial.print("Failed to initialize ");
-            Serial.print(_sensorType);
-            Serial.print(" at address 0x");
-            Serial.println(_i2cAddress, HEX);
+            LOG_ERROR("Failed to initialize %s at address 0x%02X", _sensorType, _i2cAddress);
             return false;
         } else {
-            Serial.print(_sensorType);
-            Serial.print(" initialized at address 0x");
-            Serial.println(_i2cAddress, HEX);
+            LOG_INFO("%s initialized at address 0x%02X", _sensorType, _i2cAddress);
             return true;
         }
     }
@@ -66,8 +61,7 @@ public:
         
         // Check for NaN values (sensor error)
         if (isnan(tempC) || isnan(humidity) || isnan(pressurePa)) {
-            Serial.print(_sensorType);
-            Serial.println(" read failed - NaN values");
+            LOG_WARN("%s read failed - NaN values", _sensorType);
             _hasValidReading = false;
             return false;
         }
@@ -79,43 +73,33 @@ public:
         _lastReadTimestamp = timestamp;
         _hasValidReading = true;
         
-        Serial.print(_sensorType);
-        Serial.print(" read: ");
-        Serial.print(tempC);
-        Serial.print("°C, ");
-        Serial.print(humidity);
-        Serial.print("% RH, ");
-        Serial.print(pressurePa);
-        Serial.print(" Pa at ");
-        Serial.println(timestamp);
-        
+        LOG_DEBUG("%s read: %.2f C, %.2f %% RH, %.2f Pa at %s",
+                  _sensorType, tempC, humidity, pressurePa, timestamp.c_str());
+
         return true;
     }
     
-    std::vector<SensorReading> getAllReadings() override {
-        std::vector<SensorReading> readings;
-        
+    size_t getReadingViews(ReadingView* out, size_t maxReadings) override {
         if (!_hasValidReading) {
-            Serial.print(_sensorType);
-            Serial.println(": No valid reading available");
-            return readings;  // Return empty vector
+            LOG_WARN("%s: No valid reading available", _sensorType);
+            return 0;
         }
-        
-        // Use the timestamp from when the reading was actually taken
-        String timestamp = _lastReadTimestamp;
-        
+        if (maxReadings < 3) {
+            return 0;
+        }
+
         // Temperature reading
-        float tempValue = _convertToFahrenheit ? 
+        float tempValue = _convertToFahrenheit ?
             (_lastTemperatureC * 9.0f / 5.0f + 32.0f) : _lastTemperatureC;
-        readings.emplace_back(_temperatureTopic, String(tempValue, 2), timestamp, _temperatureUUID);
-        
+        out[0] = ReadingView{_temperatureTopic, _temperatureUUID, tempValue, 2};
+
         // Humidity reading
-        readings.emplace_back(_humidityTopic, String(_lastHumidity, 2), timestamp, _humidityUUID);
-        
+        out[1] = ReadingView{_humidityTopic, _humidityUUID, _lastHumidity, 2};
+
         // Pressure reading (always in Pascals as per config)
-        readings.emplace_back(_pressureTopic, String(_lastPressurePa, 2), timestamp, _pressureUUID);
-        
-        return readings;
+        out[2] = ReadingView{_pressureTopic, _pressureUUID, _lastPressurePa, 2};
+
+        return 3;
     }
 };
 
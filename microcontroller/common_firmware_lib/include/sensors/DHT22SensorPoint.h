@@ -3,6 +3,7 @@
 
 #include "SensorPoint.h"
 #include "SensorReadTimes.h"
+#include "../utils/Log.h"
 #include "SensorConfigs.h"  // For DHT22Config struct (now in same directory)
 #include <DHT.h>  // DHT sensor library
 
@@ -19,15 +20,14 @@ private:
     const char* _humidityTopic;  
     const char* _humidityUUID;
     
-    // Last successful readings with timestamp
+    // Last successful readings (timestamp lives in the SensorPoint base)
     float _lastTemperatureC;
     float _lastHumidity;
-    String _lastReadTimestamp;  // Timestamp when reading was taken
     bool _hasValidReading;
     
 public:
     DHT22SensorPoint(const DHT22Config& config)
-        : SensorPoint(DHT22_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name)
+        : SensorPoint(DHT22_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name, config.sample_interval_ms, config.cov_deadband, config.cov_heartbeat_ms)
         , _dht(config.pin, DHT22)
         , _pin(config.pin)
         , _convertToFahrenheit(config.c_to_f)
@@ -41,9 +41,7 @@ public:
     
     bool initialize() override {
         _dht.begin();
-        Serial.print(_sensorType);
-        Serial.print(" initialized on pin ");
-        Serial.println(_pin);
+        LOG_INFO("%s initialized on pin %u", _sensorType, _pin);
         return true;  // DHT.begin() doesn't return success/failure
     }
     
@@ -53,8 +51,7 @@ public:
         
         // Check for NaN values (sensor error)
         if (isnan(tempC) || isnan(humidity)) {
-            Serial.print(_sensorType);
-            Serial.println(" read failed - NaN values (check wiring/power)");
+            LOG_WARN("%s read failed - NaN values (check wiring/power)", _sensorType);
             _hasValidReading = false;
             return false;
         }
@@ -65,38 +62,29 @@ public:
         _lastReadTimestamp = timestamp;
         _hasValidReading = true;
         
-        Serial.print(_sensorType);
-        Serial.print(" read: ");
-        Serial.print(tempC);
-        Serial.print("°C, ");
-        Serial.print(humidity);
-        Serial.print("% RH at ");
-        Serial.println(timestamp);
-        
+        LOG_DEBUG("%s read: %.2f C, %.2f %% RH at %s", _sensorType, tempC, humidity, timestamp.c_str());
+
         return true;
     }
     
-    std::vector<SensorReading> getAllReadings() override {
-        std::vector<SensorReading> readings;
-        
+    size_t getReadingViews(ReadingView* out, size_t maxReadings) override {
         if (!_hasValidReading) {
-            Serial.print(_sensorType);
-            Serial.println(": No valid reading available");
-            return readings;  // Return empty vector
+            LOG_WARN("%s: No valid reading available", _sensorType);
+            return 0;
         }
-        
-        // Use the timestamp from when the reading was actually taken
-        String timestamp = _lastReadTimestamp;
-        
+        if (maxReadings < 2) {
+            return 0;
+        }
+
         // Temperature reading
-        float tempValue = _convertToFahrenheit ? 
+        float tempValue = _convertToFahrenheit ?
             (_lastTemperatureC * 9.0f / 5.0f + 32.0f) : _lastTemperatureC;
-        readings.emplace_back(_temperatureTopic, String(tempValue, 2), timestamp, _temperatureUUID);
-        
+        out[0] = ReadingView{_temperatureTopic, _temperatureUUID, tempValue, 2};
+
         // Humidity reading
-        readings.emplace_back(_humidityTopic, String(_lastHumidity, 2), timestamp, _humidityUUID);
-        
-        return readings;
+        out[1] = ReadingView{_humidityTopic, _humidityUUID, _lastHumidity, 2};
+
+        return 2;
     }
 };
 
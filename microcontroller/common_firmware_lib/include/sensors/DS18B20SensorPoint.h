@@ -3,6 +3,7 @@
 
 #include "SensorPoint.h"
 #include "SensorReadTimes.h"
+#include "../utils/Log.h"
 #include "SensorConfigs.h"  // For DS18B20Config struct (now in same directory)
 #include <OneWire.h>
 #include <DallasTemperature.h>
@@ -20,14 +21,13 @@ private:
     const char* _temperatureTopic;
     const char* _temperatureUUID;
     
-    // Last successful readings with timestamp
+    // Last successful readings (timestamps live in the SensorPoint base)
     float _lastTemperatureC;
-    String _lastReadTimestamp;  // Timestamp when reading was taken
     bool _hasValidReading;
     
 public:
     DS18B20SensorPoint(const DS18B20Config& config)
-        : SensorPoint(DS18B20_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name)
+        : SensorPoint(DS18B20_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name, config.sample_interval_ms, config.cov_deadband, config.cov_heartbeat_ms)
         , _oneWire(config.pin)
         , _sensors(&_oneWire)
         , _pin(config.pin)
@@ -44,18 +44,11 @@ public:
         // Check if any sensors are connected
         int deviceCount = _sensors.getDeviceCount();
         if (deviceCount == 0) {
-            Serial.print(_sensorType);
-            Serial.print(" initialization failed - no devices found on pin ");
-            Serial.println(_pin);
+            LOG_ERROR("%s initialization failed - no devices found on pin %u", _sensorType, _pin);
             return false;
         }
-        
-        Serial.print(_sensorType);
-        Serial.print(" initialized on pin ");
-        Serial.print(_pin);
-        Serial.print(" - found ");
-        Serial.print(deviceCount);
-        Serial.println(" device(s)");
+
+        LOG_INFO("%s initialized on pin %u - found %d device(s)", _sensorType, _pin, deviceCount);
         
         // Set resolution for better accuracy (9, 10, 11, or 12 bits)
         _sensors.setResolution(_resolutionBits);
@@ -64,33 +57,24 @@ public:
     }
     
     bool read(const String& timestamp) override {
-        Serial.print(_sensorType);
-        Serial.print(" starting requestTemperaturesByIndex(0) on pin ");
-        Serial.println(_pin);
+        LOG_DEBUG("%s starting requestTemperaturesByIndex(0) on pin %u", _sensorType, _pin);
         unsigned long startRequest = millis();
-        
+
         _sensors.requestTemperaturesByIndex(0); // Request temperature from device 0 on THIS bus only
-        
+
         unsigned long endRequest = millis();
-        Serial.print(_sensorType);
-        Serial.print(" requestTemperaturesByIndex(0) took: ");
-        Serial.print(endRequest - startRequest);
-        Serial.println(" ms");
-        
+        LOG_DEBUG("%s requestTemperaturesByIndex(0) took: %lu ms", _sensorType, endRequest - startRequest);
+
         // Read temperature from the first device (index 0)
         unsigned long startRead = millis();
         float tempC = _sensors.getTempCByIndex(0);
         unsigned long endRead = millis();
-        
-        Serial.print(_sensorType);
-        Serial.print(" getTempCByIndex() took: ");
-        Serial.print(endRead - startRead);
-        Serial.println(" ms");
+
+        LOG_DEBUG("%s getTempCByIndex() took: %lu ms", _sensorType, endRead - startRead);
         
         // Check for invalid reading (DEVICE_DISCONNECTED_C = -127.0)
         if (tempC == DEVICE_DISCONNECTED_C || tempC == 85.0) {
-            Serial.print(_sensorType);
-            Serial.println(" read failed - device disconnected or invalid reading");
+            LOG_WARN("%s read failed - device disconnected or invalid reading", _sensorType);
             _hasValidReading = false;
             return false;
         }
@@ -100,33 +84,67 @@ public:
         _lastReadTimestamp = timestamp;
         _hasValidReading = true;
         
-        Serial.print(_sensorType);
-        Serial.print(" read: ");
-        Serial.print(tempC);
-        Serial.print("°C at ");
-        Serial.println(timestamp);
+        LOG_DEBUG("%s read: %.2f C at %s", _sensorType, tempC, timestamp.c_str());
         
         return true;
     }
     
-    std::vector<SensorReading> getAllReadings() override {
-        std::vector<SensorReading> readings;
-        
+    // Two-phase read: start the conversion without blocking on it.
+    // requestTemperaturesByIndex() normally blocks for the full conversion time
+    // (~750ms at 12 bits); with setWaitForConversion(false) it returns as soon
+    // as the convert command is on the wire.
+    bool startRead(const String& timestamp) override {
+        _pendingTimestamp = timestamp;
+
+        _sensors.setWaitForConversion(false);
+        _sensors.requestTemperaturesByIndex(0); // Start conversion on device 0 on THIS bus only
+        _sensors.setWaitForConversion(true);    // Restore default for the legacy blocking read() path
+
+        markReadStarted(_sensors.millisToWaitForConversion(_resolutionBits));
+
+        LOG_DEBUG("%s conversion started on pin %u", _sensorType, _pin);
+
+        return true;
+    }
+
+    // Two-phase read: collect the converted temperature. Same validation as read().
+    bool finishRead() override {
+        markReadComplete();
+
+        float tempC = _sensors.getTempCByIndex(0);
+
+        // Check for invalid reading (DEVICE_DISCONNECTED_C = -127.0)
+        if (tempC == DEVICE_DISCONNECTED_C || tempC == 85.0) {
+            LOG_WARN("%s read failed - device disconnected or invalid reading", _sensorType);
+            _hasValidReading = false;
+            return false;
+        }
+
+        // Store successful reading with the timestamp captured at startRead()
+        _lastTemperatureC = tempC;
+        _lastReadTimestamp = _pendingTimestamp;
+        _hasValidReading = true;
+
+        LOG_DEBUG("%s read: %.2f C at %s", _sensorType, tempC, _lastReadTimestamp.c_str());
+
+        return true;
+    }
+
+    size_t getReadingViews(ReadingView* out, size_t maxReadings) override {
         if (!_hasValidReading) {
-            Serial.print(_sensorType);
-            Serial.println(": No valid reading available");
-            return readings;  // Return empty vector
+            LOG_WARN("%s: No valid reading available", _sensorType);
+            return 0;
         }
-        
-        // Use the timestamp from when the reading was actually taken
-        String timestamp = _lastReadTimestamp;
-        
+        if (maxReadings < 1) {
+            return 0;
+        }
+
         // Temperature reading
-        float tempValue = _convertToFahrenheit ? 
+        float tempValue = _convertToFahrenheit ?
             (_lastTemperatureC * 9.0f / 5.0f + 32.0f) : _lastTemperatureC;
-        readings.emplace_back(_temperatureTopic, String(tempValue, 2), timestamp, _temperatureUUID);
-        
-        return readings;
+        out[0] = ReadingView{_temperatureTopic, _temperatureUUID, tempValue, 2};
+
+        return 1;
     }
 };
 
@@ -3,6 +3,7 @@
 
 #include "SensorPoint.h"
 #include "SensorReadTimes.h"
+#include "../utils/Log.h"
 #include "SensorConfigs.h"  // For SCD4xConfig struct
 #include <SensirionI2CScd4x.h>  // SCD4x library
 #include <Wire.h>
@@ -22,12 +23,14 @@ private:
     const char* _humidityTopic;  
     const char* _humidityUUID;
     
-    // Last successful readings with timestamp
+    // Last successful readings (timestamps live in the SensorPoint base)
     uint16_t _lastCO2;
     float _lastTemperatureC;
     float _lastHumidity;
-    String _lastReadTimestamp;  // Timestamp when reading was taken
     bool _hasValidReading;
+
+    // SCD4x measure_single_shot command (datasheet section 3.10.1)
+    static const uint16_t SCD4X_CMD_MEASURE_SINGLE_SHOT = 0x219D;
     
     // SCD4x specific timing constants (using values from SensorReadTimes.h)
     static const unsigned long SCD4X_WIRE_END_DELAY_MS = 100;           // Delay after Wire.end()
@@ -46,7 +49,7 @@ private:
     
 public:
     SCD4xSensorPoint(const SCD4xConfig& config)
-        : SensorPoint(SCD4X_TOTAL_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name)  // Use actual calculated read time
+        : SensorPoint(SCD4X_TOTAL_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name, config.sample_interval_ms, config.cov_deadband, config.cov_heartbeat_ms)  // Use actual calculated read time
         , _i2cAddress(config.address)
         , _convertToFahrenheit(config.c_to_f)
         , _co2Topic(config.co2_topic)
@@ -61,24 +64,17 @@ public:
         , _hasValidReading(false) {}
     
     bool initialize() override {
-        Serial.print("Initializing ");
-        Serial.print(_sensorType);
-        Serial.print(" at address 0x");
-        Serial.println(_i2cAddress, HEX);
-        
+        LOG_INFO("Initializing %s at address 0x%02X", _sensorType, _i2cAddress);
+
         // Test I2C communication first (like the old working code)
-        Serial.println("Testing I2C communication...");
+        LOG_DEBUG("Testing I2C communication...");
         Wire.beginTransmission(_i2cAddress);
         byte error = Wire.endTransmission();
         
         if (error == 0) {
-            Serial.print("Found device at 0x");
-            Serial.println(_i2cAddress, HEX);
+            LOG_DEBUG("Found device at 0x%02X", _i2cAddress);
         } else {
-            Serial.print("No device at 0x");
-            Serial.print(_i2cAddress, HEX);
-            Serial.print(", error: ");
-            Serial.println(error);
+            LOG_ERROR("No device at 0x%02X, error: %u", _i2cAddress, error);
             return false;
         }
         
@@ -90,36 +86,29 @@ public:
         
         // Configure sensor settings
         if (!initializeSensorConfiguration()) {
-            Serial.print(_sensorType);
-            Serial.println(" sensor configuration failed");
+            LOG_ERROR("%s sensor configuration failed", _sensorType);
             return false;
         }
         
-        Serial.print(_sensorType);
-        Serial.println(" initialized successfully");
+        LOG_INFO("%s initialized successfully", _sensorType);
         return true;
     }
     
     bool read(const String& timestamp) override {
-        Serial.print(_sensorType);
-        Serial.println(" starting read sequence...");
+        LOG_DEBUG("%s starting read sequence...", _sensorType);
         
         // Reset I2C before every read (critical for reliability)
         if (!resetI2CBus()) {
-            Serial.print(_sensorType);
-            Serial.println(" I2C reset failed during read");
+            LOG_WARN("%s I2C reset failed during read", _sensorType);
             _hasValidReading = false;
             return false;
         }
         
         // Start single-shot measurement (this is BLOCKING for ~5 seconds)
-        Serial.print(_sensorType);
-        Serial.println(" starting single-shot measurement (5s blocking)...");
+        LOG_DEBUG("%s starting single-shot measurement (5s blocking)...", _sensorType);
         uint16_t error = _scd4x.measureSingleShot();
         if (error) {
-            Serial.print(_sensorType);
-            Serial.print(" measureSingleShot failed, error: ");
-            Serial.println(error);
+            LOG_WARN("%s measureSingleShot failed, error: %u", _sensorType, error);
             _hasValidReading = false;
             return false;
         }
@@ -134,25 +123,21 @@ public:
         
         error = _scd4x.readMeasurement(co2, temperature, humidity);
         if (error) {
-            Serial.print(_sensorType);
-            Serial.print(" readMeasurement failed, error: ");
-            Serial.println(error);
+            LOG_WARN("%s readMeasurement failed, error: %u", _sensorType, error);
             _hasValidReading = false;
             return false;
         }
         
         // Check for invalid readings (CO2 = 0 often indicates sensor error)
         if (co2 == 0) {
-            Serial.print(_sensorType);
-            Serial.println(" invalid CO2 reading (0 ppm)");
+            LOG_WARN("%s invalid CO2 reading (0 ppm)", _sensorType);
             _hasValidReading = false;
             return false;
         }
         
         // Check for NaN values in temperature/humidity
         if (isnan(temperature) || isnan(humidity)) {
-            Serial.print(_sensorType);
-            Serial.println(" NaN values in temperature or humidity");
+            LOG_WARN("%s NaN values in temperature or humidity", _sensorType);
             _hasValidReading = false;
             return false;
         }
@@ -164,46 +149,118 @@ public:
         _lastReadTimestamp = timestamp;
         _hasValidReading = true;
         
-        Serial.print(_sensorType);
-        Serial.print(" read successful: ");
-        Serial.print(co2);
-        Serial.print(" ppm, ");
-        Serial.print(temperature);
-        Serial.print("°C, ");
-        Serial.print(humidity);
-        Serial.print("% RH at ");
-        Serial.println(timestamp);
+        LOG_DEBUG("%s read successful: %u ppm, %.2f C, %.2f %% RH at %s",
+                  _sensorType, co2, temperature, humidity, timestamp.c_str());
         
         return true;
     }
     
-    std::vector<SensorReading> getAllReadings() override {
-        std::vector<SensorReading> readings;
-        
+    // Two-phase read: issue the single-shot command raw over Wire so we don't
+    // sit in measureSingleShot()'s 5-second internal delay. The conversion runs
+    // inside the sensor; finishRead() collects it after the ready deadline.
+    bool startRead(const String& timestamp) override {
+        _pendingTimestamp = timestamp;
+
+        // Try the fast path first: command straight onto the (hopefully healthy) bus.
+        // Fall back to the full I2C reset sequence only when the bus looks wedged.
+        if (!sendSingleShotCommand()) {
+            LOG_WARN("%s single-shot command failed - resetting I2C bus and retrying", _sensorType);
+            if (!resetI2CBus() || !sendSingleShotCommand()) {
+                LOG_WARN("%s single-shot command failed after I2C reset", _sensorType);
+                _hasValidReading = false;
+                return false;
+            }
+        }
+
+        // Measurement runs inside the sensor for ~5s; keep the conservative margin
+        markReadStarted(SCD41_READ_TIME_MS + SCD4X_ADDITIONAL_DELAY_MS);
+
+        LOG_DEBUG("%s single-shot measurement started (non-blocking)", _sensorType);
+
+        return true;
+    }
+
+    // Two-phase read: collect the measurement. Same validation as read().
+    bool finishRead() override {
+        markReadComplete();
+
+        uint16_t co2;
+        float temperature;
+        float humidity;
+
+        uint16_t error = _scd4x.readMeasurement(co2, temperature, humidity);
+        if (error) {
+            LOG_WARN("%s readMeasurement failed, error: %u", _sensorType, error);
+            _hasValidReading = false;
+            return false;
+        }
+
+        // Check for invalid readings (CO2 = 0 often indicates sensor error)
+        if (co2 == 0) {
+            LOG_WARN("%s invalid CO2 reading (0 ppm)", _sensorType);
+            _hasValidReading = false;
+            return false;
+        }
+
+        // Check for NaN values in temperature/humidity
+        if (isnan(temperature) || isnan(humidity)) {
+            LOG_WARN("%s NaN values in temperature or humidity", _sensorType);
+            _hasValidReading = false;
+            return false;
+        }
+
+        // Store successful readings with the timestamp captured at startRead()
+        _lastCO2 = co2;
+        _lastTemperatureC = temperature;
+        _lastHumidity = humidity;
+        _lastReadTimestamp = _pendingTimestamp;
+        _hasValidReading = true;
+
+        LOG_DEBUG("%s read successful: %u ppm, %.2f C, %.2f %% RH at %s",
+                  _sensorType, co2, temperature, humidity, _lastReadTimestamp.c_str());
+
+        return true;
+    }
+
+    size_t getReadingViews(ReadingView* out, size_t maxReadings) override {
         if (!_hasValidReading) {
-            Serial.print(_sensorType);
-            Serial.println(": No valid reading available");
-            return readings;  // Return empty vector
+            LOG_WARN("%s: No valid reading available", _sensorType);
+            return 0;
         }
-        
-        // Use the timestamp from when the reading was actually taken
-        String timestamp = _lastReadTimestamp;
-        
-        // CO2 reading (ppm)
-        readings.emplace_back(_co2Topic, String(_lastCO2), timestamp, _co2UUID);
-        
+        if (maxReadings < 3) {
+            return 0;
+        }
+
+        // CO2 reading (ppm, integer precision)
+        out[0] = ReadingView{_co2Topic, _co2UUID, static_cast<float>(_lastCO2), 0};
+
         // Temperature reading (convert if needed)
-        float tempValue = _convertToFahrenheit ? 
+        float tempValue = _convertToFahrenheit ?
             (_lastTemperatureC * 9.0f / 5.0f + 32.0f) : _lastTemperatureC;
-        readings.emplace_back(_temperatureTopic, String(tempValue, 2), timestamp, _temperatureUUID);
-        
+        out[1] = ReadingView{_temperatureTopic, _temperatureUUID, tempValue, 2};
+
         // Humidity reading
-        readings.emplace_back(_humidityTopic, String(_lastHumidity, 2), timestamp, _humidityUUID);
-        
-        return readings;
+        out[2] = ReadingView{_humidityTopic, _humidityUUID, _lastHumidity, 2};
+
+        return 3;
     }
 
 private:
+    bool sendSingleShotCommand() {
+        // Raw Wire transaction (same approach as the probe in initialize()) so
+        // we avoid the Sensirion driver's built-in 5000ms delay.
+        Wire.beginTransmission(_i2cAddress);
+        Wire.write(static_cast<uint8_t>(SCD4X_CMD_MEASURE_SINGLE_SHOT >> 8));
+        Wire.write(static_cast<uint8_t>(SCD4X_CMD_MEASURE_SINGLE_SHOT & 0xFF));
+        byte error = Wire.endTransmission();
+
+        if (error != 0) {
+            LOG_WARN("%s single-shot command I2C error: %u", _sensorType, error);
+            return false;
+        }
+        return true;
+    }
+
     bool resetI2CBus() {
         // Critical I2C reset sequence for SCD4x reliability
         Wire.end();
@@ -236,9 +293,7 @@ private:
         // Stop any periodic measurement that might be running
         error = _scd4x.stopPeriodicMeasurement();
         if (error) {
-            Serial.print(_sensorType);
-            Serial.print(" failed to stop periodic measurement, error: ");
-            Serial.println(error);
+            LOG_ERROR("%s failed to stop periodic measurement, error: %u", _sensorType, error);
             return false;
         }
         delay(SCD4X_CONFIG_DELAY_MS);
@@ -246,9 +301,7 @@ private:
         // Disable automatic self-calibration for consistent readings
         error = _scd4x.setAutomaticSelfCalibration(false);
         if (error) {
-            Serial.print(_sensorType);
-            Serial.print(" failed to disable auto-calibration, error: ");
-            Serial.println(error);
+            LOG_ERROR("%s failed to disable auto-calibration, error: %u", _sensorType, error);
             return false;
         }
         delay(SCD4X_CONFIG_DELAY_MS);
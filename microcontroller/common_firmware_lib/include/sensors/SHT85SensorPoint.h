@@ -3,6 +3,7 @@
 
 #include "SensorPoint.h"
 #include "SensorReadTimes.h"
+#include "../utils/Log.h"
 #include "SensorConfigs.h"  // For SHT85Config struct (now in same directory)
 #include <Adafruit_SHT31.h>  // Using SHT31 library for SHT85 (compatible)
 
@@ -19,15 +20,14 @@ private:
     const char* _humidityTopic;  
     const char* _humidityUUID;
     
-    // Last successful readings with timestamp
+    // Last successful readings (timestamp lives in the SensorPoint base)
     float _lastTemperatureC;
     float _lastHumidity;
-    String _lastReadTimestamp;  // Timestamp when reading was taken
     bool _hasValidReading;
     
 public:
     SHT85SensorPoint(const SHT85Config& config)
-        : SensorPoint(SHT85_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name)
+        : SensorPoint(SHT85_READ_TIME_MS, config.publish_interval_ms, config.main_loop_delay_ms, config.max_time_no_publish_ms, config.point_name, config.sample_interval_ms, config.cov_deadband, config.cov_heartbeat_ms)
         , _i2cAddress(config.address)
         , _convertToFahrenheit(config.c_to_f)
         , _temperatureTopic(config.temp_topic)
@@ -40,15 +40,10 @@ public:
     
     bool initialize() override {
         if (!_sht85.begin(_i2cAddress)) {
-            Serial.print("Failed to initialize ");
-            Serial.print(_sensorType);
-            Serial.print(" at address 0x");
-            Serial.println(_i2cAddress, HEX);
+            LOG_ERROR("Failed to initialize %s at address 0x%02X", _sensorType, _i2cAddress);
             return false;
         } else {
-            Serial.print(_sensorType);
-            Serial.print(" initialized at address 0x");
-            Serial.println(_i2cAddress, HEX);
+            LOG_INFO("%s initialized at address 0x%02X", _sensorType, _i2cAddress);
             return true;
         }
     }
@@ -59,8 +54,7 @@ public:
         
         // Check for NaN values (sensor error)
         if (isnan(tempC) || isnan(humidity)) {
-            Serial.print(_sensorType);
-            Serial.println(" read failed - NaN values");
+            LOG_WARN("%s read failed - NaN values", _sensorType);
             _hasValidReading = false;
             return false;
         }
@@ -71,38 +65,29 @@ public:
         _lastReadTimestamp = timestamp;
         _hasValidReading = true;
         
-        Serial.print(_sensorType);
-        Serial.print(" read: ");
-        Serial.print(tempC);
-        Serial.print("°C, ");
-        Serial.print(humidity);
-        Serial.print("% RH at ");
-        Serial.println(timestamp);
-        
+        LOG_DEBUG("%s read: %.2f C, %.2f %% RH at %s", _sensorType, tempC, humidity, timestamp.c_str());
+
         return true;
     }
     
-    std::vector<SensorReading> getAllReadings() override {
-        std::vector<SensorReading> readings;
-        
+    size_t getReadingViews(ReadingView* out, size_t maxReadings) override {
         if (!_hasValidReading) {
-            Serial.print(_sensorType);
-            Serial.println(": No valid reading available");
-            return readings;  // Return empty vector
+            LOG_WARN("%s: No valid reading available", _sensorType);
+            return 0;
         }
-        
-        // Use the timestamp from when the reading was actually taken
-        String timestamp = _lastReadTimestamp;
-        
+        if (maxReadings < 2) {
+            return 0;
+        }
+
         // Temperature reading
-        float tempValue = _convertToFahrenheit ? 
+        float tempValue = _convertToFahrenheit ?
             (_lastTemperatureC * 9.0f / 5.0f + 32.0f) : _lastTemperatureC;
-        readings.emplace_back(_temperatureTopic, String(tempValue, 2), timestamp, _temperatureUUID);
-        
+        out[0] = ReadingView{_temperatureTopic, _temperatureUUID, tempValue, 2};
+
         // Humidity reading
-        readings.emplace_back(_humidityTopic, String(_lastHumidity, 2), timestamp, _humidityUUID);
-        
-        return readings;
+        out[1] = ReadingView{_humidityTopic, _humidityUUID, _lastHumidity, 2};
+
+        return 2;
     }
 };
 
@@ -43,6 +43,10 @@ struct SHT85Config {
     const char* temp_uuid;             // UUID for temperature reading
     const char* humidity_topic;        // MQTT topic for humidity
     const char* humidity_uuid;         // UUID for humidity reading
+    unsigned long sample_interval_ms;  // Oversampling cadence between publishes (0 = disabled, publish raw reads)
+    float cov_deadband;                // Change-of-value deadband (0 = publish every interval)
+    unsigned long cov_heartbeat_ms;    // CoV heartbeat republish (0 = 10x publish interval)
+    uint32_t i2c_max_clock_hz;         // Device's max I2C clock (0 = conservative 100kHz; bus runs at the slowest device)
 };
 
 /**
@@ -61,6 +65,10 @@ struct BME280Config {
     const char* humidity_uuid;         // UUID for humidity reading
     const char* pressure_topic;        // MQTT topic for pressure
     const char* pressure_uuid;         // UUID for pressure reading
+    unsigned long sample_interval_ms;  // Oversampling cadence between publishes (0 = disabled, publish raw reads)
+    float cov_deadband;                // Change-of-value deadband (0 = publish every interval)
+    unsigned long cov_heartbeat_ms;    // CoV heartbeat republish (0 = 10x publish interval)
+    uint32_t i2c_max_clock_hz;         // Device's max I2C clock (0 = conservative 100kHz; bus runs at the slowest device)
 };
 
 /**
@@ -79,6 +87,10 @@ struct SCD4xConfig {
     const char* temp_uuid;             // UUID for temperature reading
     const char* humidity_topic;        // MQTT topic for humidity
     const char* humidity_uuid;         // UUID for humidity reading
+    unsigned long sample_interval_ms;  // Oversampling cadence between publishes (0 = disabled, publish raw reads)
+    float cov_deadband;                // Change-of-value deadband (0 = publish every interval)
+    unsigned long cov_heartbeat_ms;    // CoV heartbeat republish (0 = 10x publish interval)
+    uint32_t i2c_max_clock_hz;         // Device's max I2C clock (0 = conservative 100kHz; bus runs at the slowest device)
 };
 
 // === Digital Sensor Configuration Structs ===
@@ -97,6 +109,9 @@ struct DHT22Config {
     const char* temp_uuid;             // UUID for temperature reading
     const char* humidity_topic;        // MQTT topic for humidity
     const char* humidity_uuid;         // UUID for humidity reading
+    unsigned long sample_interval_ms;  // Oversampling cadence between publishes (0 = disabled, publish raw reads)
+    float cov_deadband;                // Change-of-value deadband (0 = publish every interval)
+    unsigned long cov_heartbeat_ms;    // CoV heartbeat republish (0 = 10x publish interval)
 };
 
 // === OneWire Sensor Configuration Structs ===
@@ -114,6 +129,9 @@ struct DS18B20Config {
     bool c_to_f;                       // Convert Celsius to Fahrenheit
     const char* temp_topic;            // MQTT topic for temperature
     const char* temp_uuid;             // UUID for temperature reading
+    unsigned long sample_interval_ms;  // Oversampling cadence between publishes (0 = disabled, publish raw reads)
+    float cov_deadband;                // Change-of-value deadband (0 = publish every interval)
+    unsigned long cov_heartbeat_ms;    // CoV heartbeat republish (0 = 10x publish interval)
 };
 
 
@@ -2,22 +2,30 @@
 #define SENSOR_POINT_H
 
 #include <Arduino.h>
-#include <vector>
+#include "../utils/IntrusiveUniqueQueue.h" // Queue-membership mixin
+#include "../utils/SensorAggregator.h" // Streaming min/max/mean accumulators
 
 #define SENSOR_PUBLISH_FUDGE_FACTOR 100 
-// Structure to hold a single sensor reading with all necessary publish info
-struct SensorReading {
+
+// Consecutive read failures before the FSM warm-reinitializes the sensor
+// hardware instead of letting the NOPUBLISH_TIMEOUT watchdog reboot the box
+#ifndef SENSOR_REINIT_FAILURE_THRESHOLD
+#define SENSOR_REINIT_FAILURE_THRESHOLD 3
+#endif
+// Allocation-free reading view: topic/uuid stay pointers into flash, the
+// value is carried as a typed number and formatted once at publish time,
+// and the timestamp is shared across the set (SensorPoint::getReadingTimestamp).
+struct ReadingView {
     const char* topic;
-    String value;
-    String timestamp; 
     const char* uuid;
-    
-    SensorReading(const char* topic, const String& value, const String& timestamp, const char* uuid)
-        : topic(topic), value(value), timestamp(timestamp), uuid(uuid) {}
+    float value;
+    uint8_t decimals;   // Formatting precision at publish time
 };
 
-// Abstract base class for all sensor types
-class SensorPoint {
+// Abstract base class for all sensor types.
+// Derives from IntrusiveQueueMember so the read queue can track membership
+// with a bit in the sensor instead of a std::set.
+class SensorPoint : public IntrusiveQueueMember {
 protected:
     unsigned long _timeNeededReadMs;     // Time required for physical sensor read
     unsigned long _lastReadAttemptMs;    // Last time we attempted to read (success or fail)
@@ -26,33 +34,290 @@ protected:
     unsigned long _mainLoopDelayMs;      // Main loop delay to account for in timing
     unsigned long _maxTimeNoPublishMs;   // Timeout for publish failure detection
     const char* _pointName;              // Human-readable point name
-    
+
+    // Intrusive publish-pending flag: set/cleared by SensorPublishQueue so
+    // pending-data checks are a member read instead of a std::set lookup
+    bool _publishPending;
+
+    // Consecutive failed reads (warm-recovery escalation input)
+    uint8_t _consecutiveReadFailures;
+
+    // Timestamps for the reading set (shared by every channel of a read):
+    // _lastReadTimestamp is the last valid reading's capture time,
+    // _pendingTimestamp is captured at startRead() for in-flight conversions
+    String _lastReadTimestamp;
+    String _pendingTimestamp;
+
+    // Oversampling mode (sample_interval_ms > 0): samples are folded into
+    // per-channel streaming aggregates between publishes, and one aggregated
+    // reading set is emitted per publish interval
+    static const size_t MAX_AGGREGATED_CHANNELS = 4;
+    unsigned long _sampleIntervalMs;
+    StreamingAggregate _aggregates[MAX_AGGREGATED_CHANNELS];
+
+    // Change-of-value mode (cov_deadband > 0): readings are published only
+    // when a channel moves more than the deadband from its last published
+    // value, plus a slow heartbeat for liveness
+    float _covDeadband;
+    unsigned long _covHeartbeatMs;          // 0 = 10x publish interval
+    float _covLastPublished[MAX_AGGREGATED_CHANNELS];
+    bool _covHasBaseline;
+    unsigned long _lastCovSuppressMs;       // Anchors read cadence after a suppressed publish
+
+    // Two-phase read bookkeeping (ADR-22 follow-up: non-blocking reads)
+    bool _readInFlight;                  // True between startRead() and finishRead()
+    bool _pendingReadResult;             // Result captured by blocking fallback in startRead()
+    unsigned long _readStartedMs;        // When startRead() was called
+    unsigned long _readReadyDelayMs;     // How long after startRead() before finishRead() may run
+
+    // Helpers for subclasses implementing a true non-blocking read:
+    // call markReadStarted() from startRead() with the sensor's conversion time,
+    // and markReadComplete() at the top of finishRead().
+    void markReadStarted(unsigned long readyDelayMs) {
+        _readInFlight = true;
+        _readStartedMs = millis();
+        _readReadyDelayMs = readyDelayMs;
+    }
+
+    void markReadComplete() {
+        _readInFlight = false;
+    }
+
 public:
-    SensorPoint(unsigned long timeNeededReadMs, unsigned long publishIntervalMs, unsigned long mainLoopDelayMs, unsigned long maxTimeNoPublishMs, const char* pointName)
+    SensorPoint(unsigned long timeNeededReadMs, unsigned long publishIntervalMs, unsigned long mainLoopDelayMs, unsigned long maxTimeNoPublishMs, const char* pointName,
+                unsigned long sampleIntervalMs = 0, float covDeadband = 0.0f, unsigned long covHeartbeatMs = 0)
         : _timeNeededReadMs(timeNeededReadMs)
         , _lastReadAttemptMs(0)
         , _lastPublishTimeMs(ULONG_MAX - publishIntervalMs)  // Initialize to trigger immediate read
         , _publishIntervalMs(publishIntervalMs)
         , _mainLoopDelayMs(mainLoopDelayMs)
         , _maxTimeNoPublishMs(maxTimeNoPublishMs)
-        , _pointName(pointName) {}
-    
+        , _pointName(pointName)
+        , _publishPending(false)
+        , _consecutiveReadFailures(0)
+        , _sampleIntervalMs(sampleIntervalMs)
+        , _covDeadband(covDeadband)
+        , _covHeartbeatMs(covHeartbeatMs)
+        , _covHasBaseline(false)
+        , _lastCovSuppressMs(ULONG_MAX - publishIntervalMs)  // Same immediate-first-read trick as _lastPublishTimeMs
+        , _readInFlight(false)
+        , _pendingReadResult(false)
+        , _readStartedMs(0)
+        , _readReadyDelayMs(0) {}
+
     virtual ~SensorPoint() = default;
-    
+
     // Initialize sensor hardware - called once during setup
     // Returns true if successful, false on error
     virtual bool initialize() = 0;
-    
+
     // Perform hardware read operation - stores values internally with timestamps
     // Returns true if successful, false on error
+    // NOTE: May block for the full conversion time. New code should prefer the
+    // two-phase startRead()/finishRead() path below.
     virtual bool read(const String& timestamp) = 0;
+
+    // === Two-phase non-blocking read API ===
+    // Phase 1: kick off the measurement and return immediately.
+    // Default implementation just runs the legacy blocking read() and records
+    // its result, so fast sensors (SHT85, BME280, DHT22) work unchanged while
+    // slow sensors (SCD4x, DS18B20) override this with a true async start.
+    // Returns true if the measurement was started (or completed) successfully.
+    virtual bool startRead(const String& timestamp) {
+        _pendingReadResult = read(timestamp);
+        markReadStarted(0);  // Ready immediately - blocking read already finished
+        return true;
+    }
+
+    // Phase 2: collect the measurement. Only call once isReadReady() is true.
+    // Returns true if the read produced valid data (same contract as read()).
+    virtual bool finishRead() {
+        markReadComplete();
+        return _pendingReadResult;
+    }
+
+    // True between startRead() and finishRead()
+    bool isReadInFlight() const {
+        return _readInFlight;
+    }
+
+    // Warm-recovery bookkeeping: the FSM records read outcomes and
+    // reinitializes the sensor hardware after a run of failures
+    void recordReadFailure() {
+        if (_consecutiveReadFailures < 255) {
+            _consecutiveReadFailures++;
+        }
+    }
+
+    void recordReadSuccess() {
+        _consecutiveReadFailures = 0;
+    }
+
+    bool needsReinitialize() const {
+        return _consecutiveReadFailures >= SENSOR_REINIT_FAILURE_THRESHOLD;
+    }
+
+    // Intrusive publish-pending flag (managed by SensorPublishQueue)
+    void setPublishPending(bool pending) {
+        _publishPending = pending;
+    }
+
+    bool hasPublishPending() const {
+        return _publishPending;
+    }
+
+    // True once the in-flight measurement's conversion deadline has passed
+    // and finishRead() may be called without blocking
+    bool isReadReady(unsigned long currentTimeMs) const {
+        return _readInFlight && (currentTimeMs - _readStartedMs >= _readReadyDelayMs);
+    }
+
+    // Milliseconds until the in-flight measurement is ready to collect
+    // (0 if already ready or no read in flight)
+    unsigned long readReadyRemainingMs(unsigned long currentTimeMs) const {
+        if (!_readInFlight) {
+            return 0;
+        }
+        unsigned long elapsed = currentTimeMs - _readStartedMs;
+        return (elapsed >= _readReadyDelayMs) ? 0 : (_readReadyDelayMs - elapsed);
+    }
+
+    // Fill out[] with up to maxReadings allocation-free reading views from
+    // the last successful read. Returns the number of channels written
+    // (0 if no valid reading). The shared timestamp comes from
+    // getReadingTimestamp().
+    virtual size_t getReadingViews(ReadingView* out, size_t maxReadings) = 0;
+
+    // Shared timestamp for the current reading set (no copy - valid until
+    // the next read completes)
+    const char* getReadingTimestamp() const {
+        return _lastReadTimestamp.c_str();
+    }
     
-    // Get all readings from last successful read operation
-    virtual std::vector<SensorReading> getAllReadings() = 0;
-    
+    // === Oversampling / aggregation (sample_interval_ms > 0 in the config) ===
+
+    bool isAggregating() const {
+        return _sampleIntervalMs > 0;
+    }
+
+    // Fold one sample's readings into the per-channel aggregates
+    // (channel order matches getReadingViews())
+    void accumulateSample(const ReadingView* views, size_t count) {
+        size_t channels = (count < MAX_AGGREGATED_CHANNELS) ? count : MAX_AGGREGATED_CHANNELS;
+        for (size_t i = 0; i < channels; i++) {
+            _aggregates[i].addSample(views[i].value);
+        }
+    }
+
+    // True once the publish interval has elapsed - since the last publish
+    // OR the last CoV suppression, whichever is more recent - and the
+    // aggregate set should be emitted. Without the suppress anchor, a
+    // deadband-suppressed window left _lastPublishTimeMs stale and every
+    // subsequent sample "aggregated" exactly one reading, defeating the
+    // oversampling that CoV + aggregation are supposed to compose into.
+    bool isTimeToPublishAggregate(unsigned long currentTimeMs) const {
+        unsigned long sincePublish = currentTimeMs - _lastPublishTimeMs;
+        unsigned long sinceSuppress = currentTimeMs - _lastCovSuppressMs;
+        unsigned long sinceAnchor = (sinceSuppress < sincePublish) ? sinceSuppress : sincePublish;
+        return sinceAnchor >= _publishIntervalMs;
+    }
+
+    // Replace the raw values in a reading set with the aggregated means
+    // and reset the accumulators for the next window
+    void buildAggregatedReadings(ReadingView* views, size_t count) {
+        size_t channels = (count < MAX_AGGREGATED_CHANNELS) ? count : MAX_AGGREGATED_CHANNELS;
+        for (size_t i = 0; i < channels; i++) {
+            if (_aggregates[i].hasSamples()) {
+                views[i].value = _aggregates[i].mean();
+            }
+            _aggregates[i].reset();
+        }
+    }
+
+    // === Change-of-value publish mode (cov_deadband > 0 in the config) ===
+
+    bool isCovEnabled() const {
+        return _covDeadband > 0.0f;
+    }
+
+    // Effective heartbeat: explicit config value, or 10x the publish
+    // interval - clamped to half the no-publish watchdog window. In the
+    // shipped configs 10x the publish interval EQUALS the watchdog window,
+    // so an unclamped default heartbeat could never land before
+    // hasNoPublishTimeoutOccurred() fired and any deadband-suppressed value
+    // became a guaranteed NOPUBLISH_TIMEOUT restart loop. Half the window
+    // leaves room for the read lead time and the publish itself.
+    unsigned long covHeartbeatMs() const {
+        unsigned long heartbeat = (_covHeartbeatMs > 0) ? _covHeartbeatMs : (_publishIntervalMs * 10);
+        if (_maxTimeNoPublishMs > 0) {
+            unsigned long watchdogSafeCeiling = _maxTimeNoPublishMs / 2;
+            if (heartbeat > watchdogSafeCeiling) {
+                heartbeat = watchdogSafeCeiling;
+            }
+        }
+        return heartbeat;
+    }
+
+    /**
+     * Decide whether a reading set should be published: always when CoV is
+     * off; otherwise when any channel moved beyond the deadband from its
+     * last published value, when no baseline exists yet, or when the
+     * heartbeat is due (downstream consumers and the no-publish watchdog
+     * still get liveness).
+     */
+    bool shouldPublishCov(const ReadingView* views, size_t count, unsigned long currentTimeMs) const {
+        if (!isCovEnabled()) {
+            return true;
+        }
+        if (!_covHasBaseline) {
+            return true;
+        }
+        if ((currentTimeMs - _lastPublishTimeMs) >= covHeartbeatMs()) {
+            return true; // Heartbeat republish
+        }
+
+        size_t channels = (count < MAX_AGGREGATED_CHANNELS) ? count : MAX_AGGREGATED_CHANNELS;
+        for (size_t i = 0; i < channels; i++) {
+            if (fabsf(views[i].value - _covLastPublished[i]) > _covDeadband) {
+                return true; // Meaningful transition
+            }
+        }
+        return false;
+    }
+
+    // Record the values just queued for publish as the new CoV baseline
+    void recordCovBaseline(const ReadingView* views, size_t count) {
+        size_t channels = (count < MAX_AGGREGATED_CHANNELS) ? count : MAX_AGGREGATED_CHANNELS;
+        for (size_t i = 0; i < channels; i++) {
+            _covLastPublished[i] = views[i].value;
+        }
+        _covHasBaseline = true;
+    }
+
+    // Record a suppressed publish so both the read cadence and the
+    // aggregation window re-anchor here instead of free-running off the
+    // stale publish time (the accumulators were reset when the suppressed
+    // aggregate was built, so a fresh full window starts from this moment)
+    void recordCovSuppressed(unsigned long currentTimeMs) {
+        _lastCovSuppressMs = currentTimeMs;
+    }
+
     // Check if this sensor needs to be read (considering both timing constraints)
     bool needToRead(unsigned long currentTimeMs) {
+        // Oversampling mode: sample on its own (faster) cadence; publish
+        // timing is handled by isTimeToPublishAggregate()
+        if (isAggregating()) {
+            unsigned long sinceLastAttempt = currentTimeMs - _lastReadAttemptMs;
+            unsigned long cadence = (_sampleIntervalMs > _timeNeededReadMs) ? _sampleIntervalMs : _timeNeededReadMs;
+            return sinceLastAttempt >= cadence;
+        }
+
         unsigned long timeSinceLastPublish = currentTimeMs - _lastPublishTimeMs;
+        unsigned long timeSinceSuppress = currentTimeMs - _lastCovSuppressMs;
+        if (timeSinceSuppress < timeSinceLastPublish) {
+            // CoV suppressed the last publish - pace reads from there
+            timeSinceLastPublish = timeSinceSuppress;
+        }
         
         // If we're past our publish interval, check if safe to retry read
         if (timeSinceLastPublish >= _publishIntervalMs) {
@@ -72,6 +337,33 @@ public:
         return closeToPublishTime && safeToRetryRead;
     }
     
+    // Milliseconds until this sensor will next need a read (0 if due now).
+    // Mirrors the needToRead() timing math: the read should start early
+    // enough that conversion + loop delay land before the publish deadline.
+    unsigned long timeUntilNextReadMs(unsigned long currentTimeMs) const {
+        // Oversampling mode: the next event is the next sample
+        if (isAggregating()) {
+            unsigned long sinceLastAttempt = currentTimeMs - _lastReadAttemptMs;
+            unsigned long cadence = (_sampleIntervalMs > _timeNeededReadMs) ? _sampleIntervalMs : _timeNeededReadMs;
+            return (sinceLastAttempt >= cadence) ? 0 : (cadence - sinceLastAttempt);
+        }
+
+        unsigned long timeSinceLastPublish = currentTimeMs - _lastPublishTimeMs;
+        unsigned long timeSinceSuppress = currentTimeMs - _lastCovSuppressMs;
+        if (timeSinceSuppress < timeSinceLastPublish) {
+            // CoV suppressed the last publish - pace reads from there
+            timeSinceLastPublish = timeSinceSuppress;
+        }
+        if (timeSinceLastPublish >= _publishIntervalMs) {
+            return 0;
+        }
+
+        unsigned long timeUntilNextPublish = _publishIntervalMs - timeSinceLastPublish;
+        unsigned long readLeadTime = _timeNeededReadMs + _mainLoopDelayMs + SENSOR_PUBLISH_FUDGE_FACTOR;
+
+        return (timeUntilNextPublish > readLeadTime) ? (timeUntilNextPublish - readLeadTime) : 0;
+    }
+
     // Update timing after successful read attempt (called by FSM)
     void updateLastReadAttempt(unsigned long currentTimeMs) {
         _lastReadAttemptMs = currentTimeMs;
@@ -0,0 +1,83 @@
+#ifndef DEEP_SLEEP_SCHEDULER_H
+#define DEEP_SLEEP_SCHEDULER_H
+
+#include <Arduino.h>
+#include <vector>
+#include "../sensors/SensorPoint.h"
+
+// Forward declarations
+class NtpService;
+
+// Opt-in battery mode: define ENABLE_DEEP_SLEEP_MODE=1 in build_flags for
+// sensor-only controllers deployed on battery. After the publish queue
+// drains, the firmware computes the next read deadline across all sensors
+// and deep-sleeps until then instead of idling at ~80mA.
+#ifndef ENABLE_DEEP_SLEEP_MODE
+#define ENABLE_DEEP_SLEEP_MODE 0
+#endif
+
+// Don't bother sleeping for less than this - the WiFi/MQTT reconnect cost
+// on wake would outweigh the savings
+#ifndef DEEP_SLEEP_MIN_SLEEP_MS
+#define DEEP_SLEEP_MIN_SLEEP_MS 20000UL
+#endif
+
+// Margin subtracted from the computed deadline so the connect ladder
+// (WiFi + MQTT, ~2-5s with a warm AP) completes before the read is due
+#ifndef DEEP_SLEEP_WAKE_MARGIN_MS
+#define DEEP_SLEEP_WAKE_MARGIN_MS 5000UL
+#endif
+
+/**
+ * DeepSleepScheduler
+ *
+ * Purpose: Deep-sleep duty cycling for battery-powered sensor nodes. The
+ * sensor cadence already lives in SensorPoint (publish interval + read lead
+ * time), so the scheduler just takes the minimum timeUntilNextReadMs()
+ * across the sensor set, persists a small carryover block in RTC memory,
+ * and enters ESP32 timer deep sleep.
+ *
+ * On wake, setup() runs again (deep sleep resets RAM), but:
+ *  - restoreCarriedTime() re-seeds the system clock from the carried epoch
+ *    plus the slept duration, so SYNC_NTP passes immediately instead of
+ *    blocking on a fresh NTP round trip
+ *  - isTimerWake() lets the FSM skip the boot-status publish (each wake is
+ *    not a restart worth reporting)
+ *
+ * All methods are static - the state that matters lives in RTC memory.
+ */
+class DeepSleepScheduler {
+public:
+    /**
+     * True if this boot is a timer wake from our own deep sleep with a
+     * valid RTC carryover block (as opposed to a cold boot or crash).
+     */
+    static bool isTimerWake();
+
+    /**
+     * Re-seed the system clock from the carried epoch + slept duration.
+     * Call early in setup() on a timer wake, before NtpService is used.
+     * The restored time is NTP-quality minus timer drift over one sleep
+     * interval; the periodic NTP update re-trues it once WiFi is up.
+     *
+     * @return true if time was restored
+     */
+    static bool restoreCarriedTime();
+
+    /**
+     * Compute how long to sleep: the earliest read deadline across all
+     * sensors, minus the wake margin. Returns 0 if any sensor is due now.
+     */
+    static unsigned long computeSleepDurationMs(const std::vector<SensorPoint*>& sensors);
+
+    /**
+     * Persist the carryover block to RTC memory and enter timer deep sleep.
+     * Never returns.
+     *
+     * @param durationMs How long to sleep
+     * @param ntp NtpService, for the epoch to carry across the sleep
+     */
+    static void enterDeepSleep(unsigned long durationMs, NtpService& ntp);
+};
+
+#endif // DEEP_SLEEP_SCHEDULER_H
@@ -5,18 +5,29 @@
 #include <WiFiClient.h>      // For PubSubClient
 #include <PubSubClient.h>    // The MQTT client library
 #include "NtpService.h"      // To get timestamps for MQTT payloads
+#include "../PublishData.h"  // For BatchReadingEntry (batched payloads)
 #include "../utils/JsonBuilder.h"     // To build the JSON part of the payload
-#include <map>               // For topic-to-actuator mapping
-#include <queue>             // For command processing queue
-#include <set>               // For actuator tracking set
-// #include "CommandQueue.h" // Will be needed later for P1.C2.4
+#include "freertos/FreeRTOS.h" // For the client mutex (dual-core mode)
+#include "freertos/semphr.h"
+#include "../utils/TopicDispatchTable.h" // Hash-based topic -> actuator dispatch
 
-// Forward declaration to avoid circular includes
+// Forward declarations to avoid circular includes
 class ActuatorControlPoint;
+class ThreadSafeCommandQueue;
+class OtaUpdateService;
 
 // Default MQTT configuration (will later come from autogen_config.h)
 #define MQTT_RECONNECT_INTERVAL 5000 // Milliseconds
 
+// MQTT client packet buffer for the non-streaming publish paths and inbound
+// messages. Owned by begin() - sized once, explicitly, instead of every
+// payload silently fighting PubSubClient's 256-byte default. Large payloads
+// (batches, telemetry) go through the streaming path, which bypasses this
+// buffer entirely. Override in build_flags.
+#ifndef MQTT_CLIENT_BUFFER_SIZE
+#define MQTT_CLIENT_BUFFER_SIZE 640
+#endif
+
 class MqttService {
 public:
     // Constructor: Takes MQTT broker details and client credentials.
@@ -27,15 +38,16 @@ public:
     // Initializes the MQTT client and sets the callback.
     void begin();
 
-    // Set references to command management structures (called from main.cpp setup)
+    // Set references to command management structures (called from main.cpp setup).
+    // The dispatch table is const and read-only; the command queue is internally
+    // thread-safe so the callback may run on a different core than the FSM.
     void setCommandManagement(
-        std::map<String, ActuatorControlPoint*>* topicToActuatorMap,
-        std::map<ActuatorControlPoint*, String>* pendingCommands,
-        std::queue<ActuatorControlPoint*>* processQueue,
-        std::set<ActuatorControlPoint*>* processSet
+        const TopicDispatchEntry* dispatchEntries, size_t dispatchCount,
+        ThreadSafeCommandQueue* commandQueue
     );
 
-    // Main loop function for the MQTT client. Call this regularly.
+    // Main loop function for the MQTT client. Call this regularly
+    // (or let NetworkTask call it from core 0 in dual-core mode).
     bool loop();
 
     // Attempts to connect to the MQTT broker. Performs a single connection attempt.
@@ -46,6 +58,11 @@ public:
     // Checks if the MQTT client is currently connected.
     bool isConnected();
 
+    // Warm-recovery tier: tear down the MQTT session and underlying TCP
+    // socket so the next connectBroker() builds a completely fresh
+    // connection - used before escalating a connect timeout to a restart.
+    void resetConnection();
+
     // Publishes a JSON payload to the specified topic.
     // The caller is responsible for providing the correct timestamp_utc and UUID.
     // These methods will use JsonBuilder to construct the ADR-10 payload and then publish it.
@@ -57,10 +74,51 @@ public:
     bool publishJson(const char* topic, const String& timestamp_utc, const String& uuid, double value, int decimalPlaces = 2);
     bool publishJson(const char* topic, const String& timestamp_utc, const String& uuid, bool value);
 
+    // Zero-allocation publish path: the ADR-10 payload is built with
+    // JsonBuilder::buildPayloadInto() into a stack buffer, so steady-state
+    // publishing causes no heap churn (heap fragmentation was rebooting
+    // long-uptime controllers). Selected by passing const char* timestamp/uuid.
+    bool publishJson(const char* topic, const char* timestamp_utc, const char* uuid, const char* value);
+    bool publishJson(const char* topic, const char* timestamp_utc, const char* uuid, int value);
+    bool publishJson(const char* topic, const char* timestamp_utc, const char* uuid, float value, int decimalPlaces = 2);
+
+    // Batched publish path (ENABLE_BATCHED_SENSOR_PUBLISH): one message per
+    // sensor read carrying all its {uuid, value} entries plus one shared
+    // timestamp_utc. Built zero-allocation on the stack like publishJson.
+    bool publishJsonBatch(const char* topic, const char* timestamp_utc,
+                          const BatchReadingEntry* entries, size_t entryCount);
+
+    // Publish a pre-built payload verbatim (telemetry summaries and other
+    // non-ADR-10 diagnostics). Mutex-guarded like the other publish paths.
+    bool publishRaw(const char* topic, const char* payload);
+
+    // === Streaming publish path ===
+    // Serialize a payload straight into the socket in chunks via
+    // PubSubClient's beginPublish()/write()/endPublish() - the packet buffer
+    // is bypassed, so payload size isn't bounded by MQTT_CLIENT_BUFFER_SIZE
+    // and the bytes are copied once (formatter -> socket) instead of twice.
+    // The client mutex is held from beginStreamPublish() until
+    // endStreamPublish(); always pair them.
+    bool beginStreamPublish(const char* topic, size_t payloadLength);
+    size_t streamWrite(const uint8_t* data, size_t length);
+    bool endStreamPublish();
+
     // Subscribe to a topic for receiving commands
     // Returns true if subscription was successful, false otherwise
     bool subscribe(const char* topic);
 
+    // Register the OTA service; its messages (binary chunks included) are
+    // routed to it before any command parsing or logging touches the payload
+    void setOtaService(OtaUpdateService* otaService);
+
+#ifdef ENABLE_BENCHMARK_HOOKS
+    // Benchmark seam (env:benchmark only): drive the inbound parse path
+    // with canned payloads without a live broker
+    void injectMessageForBenchmark(char* topic, byte* payload, unsigned int length) {
+        instanceMqttCallback(topic, payload, length);
+    }
+#endif
+
 private:
     WiFiClient wifiClient;      // Underlying TCP client for MQTT
     PubSubClient mqttClient;    // The actual MQTT client
@@ -74,10 +132,19 @@ private:
     String _password;
 
     // References to command management structures (set by main.cpp)
-    std::map<String, ActuatorControlPoint*>* _topicToActuatorMap;
-    std::map<ActuatorControlPoint*, String>* _pendingCommands;
-    std::queue<ActuatorControlPoint*>* _processQueue;
-    std::set<ActuatorControlPoint*>* _processSet;
+    const TopicDispatchEntry* _dispatchEntries;
+    size_t _dispatchCount;
+    ThreadSafeCommandQueue* _commandQueue;
+    OtaUpdateService* _otaService;
+
+    // Serializes all PubSubClient access so the FSM (core 1) and NetworkTask
+    // (core 0) can both use this service. Recursive because connectBroker()
+    // and the publish helpers call isConnected() internally.
+    SemaphoreHandle_t _clientMutex;
+
+    // Common publish path: error-check the built payload and publish it
+    // while holding the client mutex
+    bool publishBuiltPayload(const char* topic, const String& payload);
 
     // Static callback function required by PubSubClient library.
     static void staticMqttCallback(char* topic, byte* payload, unsigned int length);
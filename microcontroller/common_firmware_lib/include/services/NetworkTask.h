@@ -0,0 +1,70 @@
+#ifndef NETWORK_TASK_H
+#define NETWORK_TASK_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Forward declarations to avoid circular includes
+class MqttService;
+class NtpService;
+
+// Opt-in dual-core mode: define ENABLE_DUAL_CORE_TASKS=1 in the controller's
+// build_flags to run WiFi/MQTT/NTP servicing in a pinned FreeRTOS task on
+// core 0 while the Arduino loop() (the sensor/actuator FSM) stays on core 1.
+// With the flag off, the controllers keep the single-loop behavior and this
+// service compiles but is never started.
+#ifndef ENABLE_DUAL_CORE_TASKS
+#define ENABLE_DUAL_CORE_TASKS 0
+#endif
+
+/**
+ * NetworkTask Service
+ *
+ * Purpose: Runs the network-facing services (MqttService::loop() and
+ * NtpService::update()) in a FreeRTOS task pinned to core 0, so a slow
+ * sensor bus on the FSM side (core 1) can no longer delay MQTT keepalive,
+ * and vice versa.
+ *
+ * Thread safety: MqttService serializes all PubSubClient access behind an
+ * internal recursive mutex, so the FSM can keep calling connectBroker(),
+ * publishJson() and subscribe() from core 1 while this task services loop()
+ * on core 0. Inbound commands land in the ThreadSafeCommandQueue.
+ */
+class NetworkTask {
+public:
+    NetworkTask();
+
+    /**
+     * Start the pinned network task on core 0.
+     * Call once from setup() after mqttService.begin().
+     *
+     * @param mqtt Reference to the controller's MqttService
+     * @param ntp Reference to the controller's NtpService
+     * @return true if the task was created successfully
+     */
+    bool begin(MqttService& mqtt, NtpService& ntp);
+
+    // Check whether the network task is running
+    bool isRunning() const;
+
+private:
+    // Task configuration
+    static const uint32_t NETWORK_TASK_STACK_SIZE = 4096;   // Words are bytes on ESP32 Arduino
+    static const UBaseType_t NETWORK_TASK_PRIORITY = 1;     // Same as loopTask - no starvation either way
+    static const BaseType_t NETWORK_TASK_CORE = 0;          // WiFi/LwIP already live on core 0
+    static const TickType_t NETWORK_TASK_INTERVAL_TICKS = pdMS_TO_TICKS(10);
+    static const unsigned long NTP_TASK_UPDATE_INTERVAL_MS = 60000; // NTP status check cadence
+
+    MqttService* _mqttService;
+    NtpService* _ntpService;
+    TaskHandle_t _taskHandle;
+
+    // FreeRTOS task entry point (static trampoline into run())
+    static void taskEntry(void* instance);
+
+    // The actual task loop: service MQTT every tick, NTP on its own cadence
+    void run();
+};
+
+#endif // NETWORK_TASK_H
@@ -2,6 +2,7 @@
 #define NTPSERVICE_H
 
 #include <Arduino.h>
+#include <time.h> // For time_t (cached timestamp second)
 // #include <NTPClient.h> // No longer using NTPClient directly
 // #include <WiFiUdp.h>   // No longer using WiFiUDP directly here
 
@@ -11,6 +12,9 @@
 
 class NtpService {
 public:
+    // Buffer size for "YYYY-MM-DDTHH:MM:SS.sssZ" + null terminator
+    static const size_t ISO8601_BUFFER_SIZE = 25;
+
     NtpService();
     void begin(); // Method to initialize NTP (will call configTime)
     bool update(); // Method to check system time sync status
@@ -18,10 +22,45 @@ public:
     unsigned long getEpochTime()     const; // Method to get current epoch time from system
     bool isTimeSet() const; // Check if time has been successfully set at least once
 
+    // Allocation-free timestamp accessors. The formatted prefix only changes
+    // once a second, so these reuse a cached buffer and just patch the
+    // millisecond digits on repeat calls within the same second - no gmtime,
+    // no sprintf, no String on the hot path.
+
+    // Returns a pointer to the internal cached timestamp ("Time not set"
+    // before sync). Valid until the next timestamp call; copy it if you
+    // need it past that.
+    const char* getIso8601Cstr() const;
+
+    // Fills the caller's buffer (>= ISO8601_BUFFER_SIZE bytes).
+    // Returns false if time is not set or the buffer is too small.
+    bool fillFormattedISO8601Time(char* buffer, size_t bufferSize) const;
+
+    // === Warm-restart time carryover (RTC-noinit memory) ===
+    // Stash the current epoch in RTC memory; call immediately before
+    // ESP.restart() (the FSM's RESTART state does this). On the next boot,
+    // begin() restores it so isTimeSet() is true instantly and the restart's
+    // first publishes carry real timestamps instead of waiting on SYNC_NTP.
+    void prepareForRestart();
+
+    // True while running on carried (restart-survived) time that real NTP
+    // hasn't re-trued yet. Carried time is accurate to within the reboot
+    // duration (~1-2s); the periodic NTP update corrects it.
+    bool isTimeCarried() const;
+
 private:
     // WiFiUDP ntpUDP; // Removed
     // NTPClient timeClient; // Removed
     bool timeSuccessfullySet;
+    bool timeCarriedFromRestart;
+
+    // Cached formatted timestamp for the current second (see refreshCachedTimestamp)
+    mutable char _cachedTimestamp[ISO8601_BUFFER_SIZE];
+    mutable time_t _cachedSecond;
+
+    // Bring the cached buffer up to date: full reformat when the second has
+    // rolled over, otherwise patch just the millisecond digits in place
+    void refreshCachedTimestamp() const;
     // unsigned long lastSyncAttempt;
     // unsigned long syncInterval; // How often to try to sync if not set
     // RestartReasonLogger* restartLogger; // Optional: for logging NTP_TIMEOUT
@@ -0,0 +1,135 @@
+#ifndef OTA_UPDATE_SERVICE_H
+#define OTA_UPDATE_SERVICE_H
+
+#include <Arduino.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+
+// Forward declarations
+class MqttService;
+
+/**
+ * OtaUpdateService
+ *
+ * Purpose: Over-the-air firmware updates over the existing MQTT connection,
+ * using the ESP32 dual app partitions, with optional binary delta transfer
+ * so a typical update ships tens of kilobytes instead of the full ~1.2MB
+ * image over congested 2.4GHz WiFi.
+ *
+ * Protocol (single subscription on the OTA control topic). Every message
+ * starts with a one-byte type tag - the discriminator is out of band, so no
+ * chunk content (e.g. a sequence number that happens to be '{') can ever be
+ * misrouted:
+ *  - 'C' + JSON control message:
+ *      {"action":"begin","size":<imageBytes>,"delta":<0|1>}
+ *      {"action":"commit"}   - after all chunks: validate and arm the reboot
+ *      {"action":"abort"}
+ *  - 'D' + 4-byte little-endian chunk sequence number + payload bytes.
+ *    Chunks must arrive in order; out-of-order chunks abort the transfer
+ *    (the sender retries the whole update).
+ *
+ * Delta format (applied against the RUNNING partition, so sender must diff
+ * against the exact deployed version):
+ *  - Stream of records inside the chunked payload:
+ *      0x00 <srcOffset u32le> <length u32le>        COPY from running image
+ *      0x01 <length u32le> <raw bytes...>           ADD literal bytes
+ *  - Records may span chunk boundaries; the applier is incremental.
+ *
+ * The FSM polls isReadyToReboot() from its periodic checks and performs the
+ * restart through the normal RESTART state with the FIRMWARE_UPDATE reason,
+ * so the update shows up in the restart-reason history like any other
+ * restart.
+ *
+ * Rollback safety REQUIRES CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE in the
+ * sdkconfig - which the stock arduino-esp32 build does NOT enable. With it,
+ * the new image boots in pending-verify state and the bootloader reverts
+ * unless markRunningImageValid() runs once MQTT is back up. Without it,
+ * esp_ota_set_boot_partition() makes the new image bootable unconditionally,
+ * markRunningImageValid() is a no-op, and a bad image that passes
+ * esp_ota_end()'s structural validation will boot-loop - commitTransfer()
+ * detects this (esp_ota_check_rollback_is_possible()) and logs a loud
+ * warning so fleets running without rollback know the safety net is absent.
+ */
+class OtaUpdateService {
+public:
+    OtaUpdateService();
+
+    /**
+     * Subscribe to the OTA control topic. Call after each successful MQTT
+     * connect (subscriptions don't survive reconnects).
+     *
+     * @param mqtt The MQTT service to subscribe through
+     * @param controlTopic The OTA control topic for this controller
+     * @return true if the subscription succeeded
+     */
+    bool subscribe(MqttService& mqtt, const char* controlTopic);
+
+    /**
+     * Handle an inbound MQTT message. Returns true if the message was an
+     * OTA message (consumed), false if it belongs to someone else.
+     * Called from MqttService's callback.
+     */
+    bool handleMessage(const char* topic, const uint8_t* payload, unsigned int length);
+
+    /**
+     * True once a complete image has been received, validated and is
+     * waiting for the FSM to reboot into it.
+     */
+    bool isReadyToReboot() const;
+
+    /**
+     * True while a transfer is in progress (FSM should avoid deep sleep
+     * and maintenance restarts while this holds).
+     */
+    bool isTransferActive() const;
+
+    /**
+     * Mark the currently running image as valid. Call once after boot when
+     * MQTT is connected - with rollback enabled in the bootloader, until
+     * then the bootloader will revert to the previous image on the next
+     * reset if we crash (no-op on builds without
+     * CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE).
+     */
+    static void markRunningImageValid();
+
+private:
+    enum OtaState {
+        OTA_IDLE = 0,
+        OTA_RECEIVING,
+        OTA_READY
+    };
+
+    OtaState _state;
+    const char* _controlTopic;       // Set by subscribe()
+    esp_ota_handle_t _otaHandle;
+    const esp_partition_t* _updatePartition;
+    const esp_partition_t* _runningPartition;
+    uint32_t _expectedImageSize;     // Final image size from "begin"
+    uint32_t _writtenBytes;          // Bytes written to the update partition
+    uint32_t _nextChunkSeq;          // Expected next chunk sequence number
+    bool _deltaMode;
+
+    // Incremental delta-applier state (records can span chunks)
+    uint8_t _recordHeader[9];        // op + two u32 fields worst case
+    uint32_t _recordHeaderFill;
+    uint8_t _recordOp;               // Current record op (COPY/ADD)
+    uint32_t _recordRemaining;       // Bytes left in the current record body
+    uint32_t _recordSrcOffset;       // COPY source cursor in the running image
+    bool _recordActive;
+
+    bool handleControlMessage(const uint8_t* payload, unsigned int length);
+    bool handleDataChunk(const uint8_t* payload, unsigned int length);
+
+    bool beginTransfer(uint32_t imageSize, bool delta);
+    bool commitTransfer();
+    void abortTransfer(const char* reason);
+
+    // Raw (full-image) path: write chunk bytes straight to the partition
+    bool writeImageBytes(const uint8_t* data, uint32_t length);
+
+    // Delta path: feed chunk bytes through the record applier
+    bool applyDeltaBytes(const uint8_t* data, uint32_t length);
+    bool applyCopyRecord(uint32_t srcOffset, uint32_t length);
+};
+
+#endif // OTA_UPDATE_SERVICE_H
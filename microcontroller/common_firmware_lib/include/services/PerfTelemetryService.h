@@ -0,0 +1,102 @@
+#ifndef PERF_TELEMETRY_SERVICE_H
+#define PERF_TELEMETRY_SERVICE_H
+
+#include <Arduino.h>
+
+// Forward declarations
+class MqttService;
+
+// How often the telemetry summary is published (override in build_flags)
+#ifndef TELEMETRY_PUBLISH_INTERVAL_MS
+#define TELEMETRY_PUBLISH_INTERVAL_MS 300000UL  // 5 minutes
+#endif
+
+/**
+ * PerfTelemetryService
+ *
+ * Purpose: On-device performance visibility. Samples main-loop iteration
+ * time into a fixed histogram, tracks free-heap minima and the largest free
+ * block (the fragmentation signal), per-FSM-state residency, and publish
+ * queue depth high-water marks, and periodically publishes a compact JSON
+ * summary on a diagnostics topic - so latency regressions can be diagnosed
+ * from the broker instead of a serial cable in a grow tent.
+ *
+ * Usage: call loopTick(currentState) once per loop() pass (it measures the
+ * time since the previous tick), recordQueueDepth() whenever convenient,
+ * and publish() from the loop tail when isTimeToPublish() says so.
+ *
+ * States are tracked by their FsmState enum value (the enum itself lives in
+ * the generated autogen_config.h, so this service keys on the integer).
+ */
+class PerfTelemetryService {
+public:
+    // Histogram bin upper bounds in microseconds; last bin is unbounded
+    static const size_t LOOP_HISTOGRAM_BINS = 8;
+    // Highest FsmState value we track residency for (matches the FSM enums)
+    static const size_t MAX_TRACKED_STATES = 12;
+
+    PerfTelemetryService();
+
+    /**
+     * Sample one main-loop iteration: the time since the previous tick is
+     * added to the loop histogram and attributed to the given FSM state.
+     * Also refreshes the heap minima. Call once per loop() pass.
+     *
+     * @param currentState The FSM state this iteration ran in (FsmState value)
+     */
+    void loopTick(int currentState);
+
+    /**
+     * Record the current publish queue depth; keeps the high-water mark.
+     */
+    void recordQueueDepth(size_t depth);
+
+    // True once TELEMETRY_PUBLISH_INTERVAL_MS has elapsed since the last publish
+    bool isTimeToPublish() const;
+
+    /**
+     * Worst loop iteration time observed (microseconds). On a single-core
+     * controller this is also the worst MQTT loop-servicing gap - the time
+     * an inbound message can wait before its callback even fires - so the
+     * command-latency surface publishes it alongside the per-actuator
+     * receipt-to-digitalWrite numbers.
+     */
+    uint32_t loopMaxUs() const;
+
+    /**
+     * Build the compact JSON summary and publish it on the given topic.
+     * Resets the publish timer (but keeps cumulative counters - consumers
+     * can diff successive summaries).
+     *
+     * @param mqtt The MQTT service to publish through
+     * @param topic Diagnostics topic to publish on
+     * @param timestampIso Current ISO8601 timestamp (e.g. ntpService.getIso8601Cstr())
+     * @return true if the summary was published
+     */
+    bool publish(MqttService& mqtt, const char* topic, const char* timestampIso);
+
+private:
+    // Loop latency histogram (bounds in LOOP_HISTOGRAM_BOUNDS_US)
+    uint32_t _loopHistogram[LOOP_HISTOGRAM_BINS];
+    uint32_t _loopCount;
+    uint32_t _loopMaxUs;
+    uint64_t _loopTotalUs;
+    unsigned long _lastTickUs;
+    bool _firstTick;
+
+    // Per-FSM-state residency in milliseconds
+    uint32_t _stateResidencyMs[MAX_TRACKED_STATES];
+
+    // Heap tracking
+    uint32_t _minFreeHeap;
+    uint32_t _minLargestBlock;
+
+    // Queue depth high-water mark
+    uint32_t _queueDepthHighWater;
+
+    unsigned long _lastPublishMs;
+
+    static const uint32_t LOOP_HISTOGRAM_BOUNDS_US[LOOP_HISTOGRAM_BINS - 1];
+};
+
+#endif // PERF_TELEMETRY_SERVICE_H
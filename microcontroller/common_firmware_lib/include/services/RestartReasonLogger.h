@@ -93,16 +93,37 @@ public:
     
     /**
      * Convert RestartReason enum to human-readable string.
-     * 
+     *
      * @param reason The restart reason enum value
      * @return String representation for MQTT payload
      */
     static String restartReasonToString(RestartReason reason);
 
+    /**
+     * Read the persistent ring of recent restart events (newest first).
+     * The ring is appended when a stored event is consumed at boot - off
+     * the restart path - and survives power loss (NVS).
+     *
+     * @param out Array receiving up to maxEvents events
+     * @param maxEvents Capacity of out
+     * @return Number of events written to out
+     */
+    size_t getRestartHistory(RestartEvent* out, size_t maxEvents);
+
+    // Depth of the persistent restart-event history ring
+    static const size_t HISTORY_SIZE = 8;
+
 private:
     static const char* PREFERENCES_NAMESPACE;
     static const char* REASON_KEY;
     static const char* TIMESTAMP_KEY;
+    static const char* HISTORY_INDEX_KEY;
+
+    /**
+     * Append a consumed restart event to the NVS history ring.
+     * Called from getStoredRestartEvent() at boot, never on the restart path.
+     */
+    void appendToHistory(const RestartEvent& event);
     
     /**
      * Clear the stored restart reason from persistent storage.
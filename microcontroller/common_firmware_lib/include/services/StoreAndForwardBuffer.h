@@ -0,0 +1,114 @@
+#ifndef STORE_AND_FORWARD_BUFFER_H
+#define STORE_AND_FORWARD_BUFFER_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "../PublishData.h"
+
+// Forward declarations
+class MqttService;
+
+// Ring geometry. 256 records x 192 bytes = 48KB of flash - roughly 21 hours
+// of a 4-sensor controller publishing every 15s, which comfortably covers an
+// overnight broker maintenance window. Override in build_flags if needed.
+#ifndef STORE_FORWARD_MAX_RECORDS
+#define STORE_FORWARD_MAX_RECORDS 256
+#endif
+
+/**
+ * StoreAndForwardBuffer Service
+ *
+ * Purpose: Flash-backed (LittleFS) circular buffer that the FSM spills the
+ * publish queue into while the MQTT broker is unreachable, so broker outages
+ * and NOPUBLISH_TIMEOUT restarts no longer cost hours of environmental data.
+ *
+ * Design: a single fixed-geometry ring file (header + fixed-size record
+ * slots). Appends are sequential slot writes; when the ring is full the
+ * oldest record is dropped (and counted). Records are stored in arrival
+ * order, which is timestamp order for sensor readings, so the streaming
+ * drain on reconnect replays them chronologically.
+ *
+ * The header (head/tail/count) is rewritten on every append/advance - small
+ * writes that LittleFS wear-levels, and they only happen during outages.
+ */
+class StoreAndForwardBuffer {
+public:
+    StoreAndForwardBuffer();
+
+    /**
+     * Mount LittleFS and open (or create) the ring file.
+     * Call once from setup(). Returns false if flash storage is unavailable,
+     * in which case store()/drain() become no-ops and data is RAM-only as before.
+     */
+    bool begin();
+
+    /**
+     * Append one publish item to the ring. Drops the oldest record (and
+     * increments the dropped counter) when the ring is full.
+     *
+     * @param data The publish item to persist (topic/uuid/value/timestamp)
+     * @return true if the record was written
+     */
+    bool store(const PublishData& data);
+
+    // True when LittleFS mounted and the ring file is usable (buffering
+    // degrades to RAM-only when this is false)
+    bool isAvailable() const;
+
+    // Check if any buffered records are waiting to be replayed
+    bool hasBufferedData() const;
+
+    // Number of buffered records waiting to be replayed
+    size_t bufferedCount() const;
+
+    /**
+     * Replay up to maxRecords buffered records through MQTT, oldest first.
+     * Stops early on the first publish failure (the record stays buffered).
+     * Call repeatedly from PUBLISH_DATA with a small maxRecords to keep each
+     * FSM pass bounded.
+     *
+     * @param mqtt The MQTT service to publish through
+     * @param maxRecords Max records to replay this call
+     * @return Number of records successfully replayed
+     */
+    size_t drain(MqttService& mqtt, size_t maxRecords);
+
+    // Records dropped because the ring was full (for diagnostics)
+    uint32_t getDroppedRecordCount() const;
+
+private:
+    // Fixed on-flash record layout. Strings are NUL-terminated within their
+    // fields; anything longer is truncated at store() time.
+    struct Record {
+        char topic[96];
+        char uuid[40];
+        char value[24];
+        char timestamp[28];
+        uint32_t reserved;  // Pad to 192 bytes for future use
+    };
+
+    // Ring file header, rewritten as head/tail move
+    struct Header {
+        uint32_t magic;     // RING_MAGIC - also invalidates stale geometry
+        uint32_t head;      // Oldest record slot
+        uint32_t tail;      // Next append slot
+        uint32_t count;     // Records currently buffered
+    };
+
+    static const uint32_t RING_MAGIC = 0x53414642;  // "SAFB"
+    static const char* RING_FILE_PATH;
+
+    File _file;
+    Header _header;
+    bool _available;            // LittleFS mounted and ring file valid
+    uint32_t _droppedRecords;   // Oldest-record drops since boot
+
+    // Persist the in-RAM header to the start of the ring file
+    bool writeHeader();
+
+    // Read/write one record slot (slot index, not byte offset)
+    bool readRecord(uint32_t slot, Record& record);
+    bool writeRecord(uint32_t slot, const Record& record);
+};
+
+#endif // STORE_AND_FORWARD_BUFFER_H
@@ -0,0 +1,75 @@
+#ifndef WIFI_FAST_CONNECT_H
+#define WIFI_FAST_CONNECT_H
+
+#include <Arduino.h>
+
+/**
+ * WifiFastConnect Service
+ *
+ * Purpose: Sub-second WiFi reconnects. A bare WiFi.begin(ssid, pass) costs
+ * 4-8s per attempt (full channel scan + DHCP). This service persists the
+ * last successful BSSID, channel and DHCP lease in NVS and tries the
+ * targeted WiFi.begin(ssid, pass, channel, bssid) path with a static copy
+ * of the lease first - skipping both the scan and DHCP - falling back to
+ * the full scan path if the targeted attempt times out (AP replaced,
+ * channel changed, lease stale).
+ *
+ * FSM integration (CONNECT_WIFI):
+ *  - startAttempt() instead of WiFi.begin() when starting an attempt
+ *  - onAttemptFailed() when an attempt times out (disables the fast path
+ *    for the rest of this boot so the existing wifiAttempts retry ladder
+ *    proceeds with full scans)
+ *  - onConnected() on success (persists the parameters, NVS write only
+ *    when something actually changed)
+ */
+class WifiFastConnect {
+public:
+    WifiFastConnect();
+
+    // Load cached connection parameters from NVS. Call once from setup().
+    void begin();
+
+    /**
+     * Start a WiFi connection attempt: targeted (cached channel + BSSID +
+     * static lease) when the cache is valid and hasn't failed this boot,
+     * otherwise the normal full-scan DHCP path.
+     */
+    void startAttempt(const char* ssid, const char* password);
+
+    /**
+     * Record a successful connection: persist BSSID/channel/lease to NVS
+     * (skipped when unchanged, to avoid NVS wear).
+     */
+    void onConnected();
+
+    /**
+     * Record a timed-out attempt: invalidates the fast path for the rest
+     * of this boot so subsequent attempts use the full scan.
+     */
+    void onAttemptFailed();
+
+    // True if the current/last attempt used the targeted fast path
+    bool usedFastPath() const;
+
+private:
+    struct CachedParams {
+        uint32_t valid;      // CACHE_MAGIC when the rest is usable
+        uint8_t bssid[6];
+        uint8_t padding[2];
+        int32_t channel;
+        uint32_t ip;
+        uint32_t gateway;
+        uint32_t subnet;
+        uint32_t dns;
+    };
+
+    static const uint32_t CACHE_MAGIC = 0x57464331; // "WFC1"
+    static const char* PREFERENCES_NAMESPACE;
+    static const char* PARAMS_KEY;
+
+    CachedParams _cache;
+    bool _fastPathAvailable;    // Cache valid and not yet failed this boot
+    bool _usedFastPath;         // Last attempt used the targeted path
+};
+
+#endif // WIFI_FAST_CONNECT_H
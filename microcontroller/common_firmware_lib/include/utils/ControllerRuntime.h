@@ -0,0 +1,266 @@
+#ifndef CONTROLLER_RUNTIME_H
+#define CONTROLLER_RUNTIME_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "FsmUtils.h"
+#include "Log.h"
+#include "../PublishData.h"
+#include "../services/NtpService.h"
+#include "../services/MqttService.h"
+#include "../services/RestartReasonLogger.h"
+#include "../services/WifiFastConnect.h"
+#include "../services/OtaUpdateService.h"
+
+/**
+ * @brief Shared controller runtime: the connectivity FSM every controller ran
+ * as a private copy
+ *
+ * controller1/2/3 each carried byte-identical CONNECT_WIFI / SYNC_NTP /
+ * CONNECT_MQTT / PUBLISH_BOOT_STATUS machinery (attempt ladders, warm
+ * recovery, fast connect, boot-status publishing). This template owns that
+ * machinery once; each controller supplies a compile-time Traits policy for
+ * the parts that differ:
+ *
+ *   struct C1RuntimeTraits {
+ *       static const char* lastRestartReasonTopic();
+ *       static const char* lastRestartReasonUuid();
+ *       static const char* otaControlTopic();
+ *       static FsmState idleWorkState();      // READ_SENSORS / PROCESS_COMMANDS
+ *       static void onMqttConnected();        // subscriptions (empty = none)
+ *       static void queueForPublish(const PublishData& data);
+ *       static bool bufferingWhileDisconnected(); // Flash spill active: yield
+ *                                             // to the idle state between
+ *                                             // MQTT attempts (so sensor
+ *                                             // work stays reachable) and
+ *                                             // defer the MQTT_TIMEOUT
+ *                                             // restart while data is
+ *                                             // being captured to flash
+ *   };
+ *
+ * Because the hooks are static Traits members resolved at compile time, a
+ * sensor-only controller's runtime contains no trace of the command
+ * subsystem - the onMqttConnected() hook inlines to nothing - and fixes to
+ * the connect ladder land on every controller at once. The
+ * composition-specific states (sensors, actuators, publishing) stay in each
+ * controller's main, where the static sensor registry / dispatch table
+ * already pin the composition at compile time.
+ */
+template<typename Traits>
+class ControllerRuntime {
+private:
+    NtpService& _ntp;
+    MqttService& _mqtt;
+    RestartReasonLogger& _restartLogger;
+    WifiFastConnect& _wifiFast;
+    OtaUpdateService& _ota;
+
+    // Attempt ladders and warm-recovery tier flags (previously file-scope
+    // statics in every main)
+    unsigned int _wifiAttempts;
+    unsigned int _ntpAttempts;
+    bool _wifiWarmRecoveryTried;
+    bool _mqttWarmRecoveryTried;
+    bool _bootStatusPublished;
+
+public:
+    ControllerRuntime(NtpService& ntp, MqttService& mqtt, RestartReasonLogger& restartLogger,
+                      WifiFastConnect& wifiFast, OtaUpdateService& ota)
+        : _ntp(ntp),
+          _mqtt(mqtt),
+          _restartLogger(restartLogger),
+          _wifiFast(wifiFast),
+          _ota(ota),
+          _wifiAttempts(0),
+          _ntpAttempts(0),
+          _wifiWarmRecoveryTried(false),
+          _mqttWarmRecoveryTried(false),
+          _bootStatusPublished(false) {}
+
+    // Boot-status suppression (deep-sleep timer wakes are not restarts)
+    void markBootStatusPublished() {
+        _bootStatusPublished = true;
+    }
+
+    bool isBootStatusPublished() const {
+        return _bootStatusPublished;
+    }
+
+    // --- CONNECT_WIFI ---
+    void handleConnectWifi(FsmState& currentState, unsigned long& stateStartTime, unsigned long currentTime) {
+        // Check if WiFi is already connected
+        if (WiFi.status() == WL_CONNECTED) {
+            Serial.println("WiFi connected successfully!");
+            Serial.print("IP Address: ");
+            Serial.println(WiFi.localIP());
+            FsmUtils::resetRetries(_wifiAttempts, "WiFi");
+            _wifiWarmRecoveryTried = false; // Warm tier re-armed by success
+            _wifiFast.onConnected(); // Persist BSSID/channel/lease for next time
+            FsmUtils::transitionToState(currentState, SYNC_NTP, stateStartTime, true); // New operation - reset timer
+            return;
+        }
+
+        // Check if this is a new attempt or timeout
+        if (_wifiAttempts == 0 || FsmUtils::checkTimeout(stateStartTime, WIFI_ATTEMPT_TIMEOUT_MS)) {
+            if (_wifiAttempts > 0) {
+                // Previous attempt timed out - if it was the targeted
+                // fast path, fall back to the full scan from here on
+                _wifiFast.onAttemptFailed();
+            }
+
+            if (FsmUtils::checkAndIncrementRetries(_wifiAttempts, MAX_WIFI_ATTEMPTS, "WiFi")) {
+                if (!_wifiWarmRecoveryTried) {
+                    // Warm tier: reinitialize the driver and rerun the
+                    // ladder once before paying for a full restart
+                    _wifiWarmRecoveryTried = true;
+                    FsmUtils::warmResetWifiDriver();
+                    _wifiAttempts = 0; // Rerun the ladder from scratch
+                    stateStartTime = currentTime;
+                    return;
+                }
+                FsmUtils::handleRestartWithReason(currentState, WIFI_TIMEOUT, _restartLogger, _ntp);
+                return;
+            }
+
+            // Start new WiFi attempt (targeted fast path when cached)
+            Serial.print(" - Connecting to: ");
+            Serial.println(WIFI_SSID);
+
+            _wifiFast.startAttempt(WIFI_SSID, WIFI_PASSWORD);
+            stateStartTime = currentTime; // Manual reset for new attempt timer
+        } else {
+            // Still waiting for current attempt
+            Serial.print(".");
+        }
+    }
+
+    // --- SYNC_NTP ---
+    void handleSyncNtp(FsmState& currentState, unsigned long& stateStartTime, unsigned long currentTime) {
+        // Initialize NTP service if this is the first attempt
+        if (_ntpAttempts == 0) {
+            Serial.println("Initializing NTP Service...");
+            _ntp.begin();
+            _ntpAttempts = 1;
+            stateStartTime = currentTime;
+        }
+
+        // Try to update/sync NTP
+        _ntp.update();
+
+        // Check if NTP is now synchronized
+        if (_ntp.isTimeSet()) {
+            Serial.println("NTP sync successful!");
+            Serial.print("Current UTC Time: ");
+            Serial.println(_ntp.getFormattedISO8601Time());
+            Serial.print("Current Epoch Time: ");
+            Serial.println(_ntp.getEpochTime());
+            FsmUtils::resetRetries(_ntpAttempts, "NTP");
+            FsmUtils::transitionToState(currentState, CONNECT_MQTT, stateStartTime, true); // New operation - reset timer
+            return;
+        }
+
+        // Check for timeout on current attempt
+        if (FsmUtils::checkTimeout(stateStartTime, NTP_ATTEMPT_TIMEOUT_MS)) {
+            if (FsmUtils::checkAndIncrementRetries(_ntpAttempts, MAX_NTP_ATTEMPTS, "NTP")) {
+                FsmUtils::handleRestartWithReason(currentState, NTP_TIMEOUT, _restartLogger, _ntp);
+                return;
+            }
+
+            // Start new NTP attempt
+            Serial.println(" - Retrying...");
+            stateStartTime = currentTime; // Manual reset for new attempt timer
+        } else {
+            // Still waiting for current attempt
+            Serial.print("n"); // NTP attempt indicator
+        }
+    }
+
+    // --- CONNECT_MQTT ---
+    void handleConnectMqtt(FsmState& currentState, unsigned long& stateStartTime, unsigned long currentTime) {
+        if (_mqtt.connectBroker()) {
+            Serial.println("MQTT connected successfully!");
+            _mqttWarmRecoveryTried = false; // Warm tier re-armed by success
+            _ota.subscribe(_mqtt, Traits::otaControlTopic());
+            // Confirm the running image so the bootloader won't roll back
+            OtaUpdateService::markRunningImageValid();
+            Traits::onMqttConnected(); // Controller-specific subscriptions
+
+            // Only publish boot status if we haven't already
+            if (!_bootStatusPublished) {
+                FsmUtils::transitionToState(currentState, PUBLISH_BOOT_STATUS, stateStartTime);
+            } else {
+                FsmUtils::transitionToState(currentState, Traits::idleWorkState(), stateStartTime);
+            }
+        } else {
+            Serial.println("MQTT connection failed, retrying...");
+
+            // Check for MQTT timeout (using constant from autogen_config.h)
+            if (FsmUtils::checkTimeout(stateStartTime, MQTT_CONNECT_TIMEOUT_MS)) {
+                if (!_mqttWarmRecoveryTried) {
+                    // Warm tier: fresh session + TCP socket, then one
+                    // more full timeout window before restarting
+                    _mqttWarmRecoveryTried = true;
+                    _mqtt.resetConnection();
+                    stateStartTime = currentTime;
+                    return;
+                }
+                if (Traits::bufferingWhileDisconnected()) {
+                    // Readings are being captured to flash - a restart would
+                    // only interrupt sampling without helping the broker come
+                    // back. Restart the timeout window and keep cycling.
+                    LOG_WARN("MQTT still down - deferring MQTT_TIMEOUT restart while buffering to flash");
+                    stateStartTime = currentTime;
+                    FsmUtils::transitionToState(currentState, WAIT, stateStartTime);
+                    return;
+                }
+                FsmUtils::handleRestartWithReason(currentState, MQTT_TIMEOUT, _restartLogger, _ntp);
+            } else {
+                if (Traits::bufferingWhileDisconnected()) {
+                    // Yield to the idle state between attempts so sensor
+                    // reads (and the flash spill) stay reachable during the
+                    // outage; WAIT routes back here when there is no sensor
+                    // work, and the timeout window keeps running meanwhile
+                    delay(MQTT_RETRY_DELAY_MS); // Retry delay from autogen_config.h
+                    FsmUtils::transitionToState(currentState, WAIT, stateStartTime);
+                    return;
+                }
+                FsmUtils::transitionToState(currentState, CONNECT_MQTT, stateStartTime); // Stay in this state, keep timer
+                delay(MQTT_RETRY_DELAY_MS); // Retry delay from autogen_config.h
+            }
+        }
+    }
+
+    // --- PUBLISH_BOOT_STATUS ---
+    void handlePublishBootStatus(FsmState& currentState, unsigned long& stateStartTime) {
+        // Always publish a restart reason - default to unknown if none stored
+        PublishData bootStatus;
+        if (_restartLogger.hasStoredRestartReason()) {
+            Serial.println("Found stored restart reason, creating publish data...");
+            bootStatus = _restartLogger.createPublishData(
+                _ntp,
+                Traits::lastRestartReasonTopic(),
+                Traits::lastRestartReasonUuid()
+            );
+        } else {
+            Serial.println("No stored restart reason found, defaulting to unknown_reset");
+            // Create PublishData for unknown restart reason
+            String timestamp = _ntp.getFormattedISO8601Time();
+            String reasonString = RestartReasonLogger::restartReasonToString(UNKNOWN_RESET);
+            bootStatus = PublishData(
+                Traits::lastRestartReasonTopic(),
+                Traits::lastRestartReasonUuid(),
+                reasonString,
+                timestamp
+            );
+        }
+
+        Traits::queueForPublish(bootStatus);
+        Serial.println("Restart reason queued for publishing");
+
+        // Mark boot status as published and transition to normal operation
+        _bootStatusPublished = true;
+        FsmUtils::transitionToState(currentState, Traits::idleWorkState(), stateStartTime);
+    }
+};
+
+#endif // CONTROLLER_RUNTIME_H
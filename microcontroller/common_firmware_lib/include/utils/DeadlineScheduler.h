@@ -0,0 +1,75 @@
+#ifndef DEADLINE_SCHEDULER_H
+#define DEADLINE_SCHEDULER_H
+
+#include <Arduino.h>
+
+// Upper bound on the tickless idle sleep. PubSubClient still needs loop()
+// serviced regularly for keepalive and inbound messages, so even a fully
+// idle controller wakes this often. Override in build_flags.
+#ifndef TICKLESS_MAX_IDLE_MS
+#define TICKLESS_MAX_IDLE_MS 250
+#endif
+
+/**
+ * @brief Earliest-deadline tracker for the tickless main loop
+ *
+ * Instead of ending every loop() pass with a fixed delay and re-polling
+ * everything, the loop registers each upcoming event - next sensor read,
+ * in-flight conversion ready time, NTP refresh, periodic checks - and
+ * sleeps exactly until the earliest one (capped by TICKLESS_MAX_IDLE_MS
+ * for MQTT servicing).
+ *
+ * Rebuilt each loop pass; registering is a comparison, so the cost is
+ * negligible next to the polling it replaces.
+ */
+class DeadlineScheduler {
+private:
+    unsigned long _minDelayMs;
+    bool _hasDeadline;
+
+public:
+    DeadlineScheduler() : _minDelayMs(0), _hasDeadline(false) {}
+
+    /**
+     * @brief Register an event due in delayMs milliseconds
+     */
+    void registerDelay(unsigned long delayMs) {
+        if (!_hasDeadline || delayMs < _minDelayMs) {
+            _minDelayMs = delayMs;
+            _hasDeadline = true;
+        }
+    }
+
+    /**
+     * @brief Register an event due at an absolute millis() timestamp
+     *
+     * Wrap-safe: an already-passed deadline registers as due now.
+     *
+     * @param dueAtMs Absolute due time (millis() domain)
+     * @param nowMs Current millis()
+     */
+    void registerDeadline(unsigned long dueAtMs, unsigned long nowMs) {
+        long remaining = static_cast<long>(dueAtMs - nowMs);
+        registerDelay(remaining <= 0 ? 0 : static_cast<unsigned long>(remaining));
+    }
+
+    /**
+     * @brief Compute how long the loop should sleep
+     *
+     * @param maxDelayMs Cap (MQTT servicing bound)
+     * @param minDelayMs Floor (avoid a zero-delay busy spin)
+     * @return Clamped delay until the earliest registered deadline
+     */
+    unsigned long nextDelayMs(unsigned long maxDelayMs, unsigned long minDelayMs = 1) const {
+        unsigned long delayMs = _hasDeadline ? _minDelayMs : maxDelayMs;
+        if (delayMs > maxDelayMs) {
+            delayMs = maxDelayMs;
+        }
+        if (delayMs < minDelayMs) {
+            delayMs = minDelayMs;
+        }
+        return delayMs;
+    }
+};
+
+#endif // DEADLINE_SCHEDULER_H
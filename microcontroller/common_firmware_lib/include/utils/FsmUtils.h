@@ -6,11 +6,20 @@
 #define FSM_UTILS_H
 
 #include <Arduino.h>
+#include <WiFi.h> // For the warm WiFi driver reset
 #include "autogen_config.h" // For FsmState enum
 #include "../services/RestartReasonLogger.h"
 #include "../services/NtpService.h"
+#include "Log.h"
 #include <vector>
 
+// Time budget for draining the publish queue in one PUBLISH_DATA pass.
+// Large enough to flush a whole multi-reading burst, small enough to keep
+// the loop responsive. Override in build_flags.
+#ifndef PUBLISH_DRAIN_BUDGET_MS
+#define PUBLISH_DRAIN_BUDGET_MS 50
+#endif
+
 namespace FsmUtils {
 
     /**
@@ -50,10 +59,7 @@ namespace FsmUtils {
                                  unsigned long &stateStartTime, bool resetTimer = false) {
         // Only log if there's an actual state change
         if (currentState != newState) {
-            Serial.print("FSM: ");
-            Serial.print(stateToString(currentState));
-            Serial.print(" -> ");
-            Serial.println(stateToString(newState));
+            LOG_DEBUG("FSM: %s -> %s", stateToString(currentState), stateToString(newState));
         }
         
         currentState = newState;
@@ -84,8 +90,8 @@ namespace FsmUtils {
      */
     inline void handleRestartWithReason(FsmState &currentState, RestartReason reason, 
                                        RestartReasonLogger &logger, NtpService &ntp) {
-        Serial.print("FSM: Restart triggered - Reason: ");
-        Serial.println(RestartReasonLogger::restartReasonToString(reason));
+        LOG_ERROR("FSM: Restart triggered - Reason: %s",
+                  RestartReasonLogger::restartReasonToString(reason).c_str());
         
         logger.storeRestartReason(reason, ntp);
         currentState = RESTART;
@@ -103,18 +109,11 @@ namespace FsmUtils {
     inline bool checkAndIncrementRetries(unsigned int &attempts, unsigned int maxAttempts, 
                                         const char* operationName) {
         attempts++;
-        
-        Serial.print(operationName);
-        Serial.print(" attempt ");
-        Serial.print(attempts);
-        Serial.print(" of ");
-        Serial.println(maxAttempts);
-        
+
+        LOG_INFO("%s attempt %u of %u", operationName, attempts, maxAttempts);
+
         if (attempts >= maxAttempts) {
-            Serial.print(operationName);
-            Serial.print(" failed after ");
-            Serial.print(maxAttempts);
-            Serial.println(" attempts");
+            LOG_ERROR("%s failed after %u attempts", operationName, maxAttempts);
             return true; // Max attempts exceeded
         }
         
@@ -129,12 +128,24 @@ namespace FsmUtils {
      */
     inline void resetRetries(unsigned int &attempts, const char* operationName) {
         if (attempts > 0) {
-            Serial.print(operationName);
-            Serial.println(" successful - retry counter reset");
+            LOG_INFO("%s successful - retry counter reset", operationName);
             attempts = 0;
         }
     }
 
+    /**
+     * Warm-recovery tier: reinitialize the WiFi driver without a reboot.
+     * Used when the connect ladder exhausts its attempts once - a full
+     * driver reinit clears wedged supplicant state that individual
+     * WiFi.begin() retries don't, at a fraction of a reboot's cost.
+     */
+    inline void warmResetWifiDriver() {
+        LOG_WARN("Warm recovery: reinitializing WiFi driver");
+        WiFi.disconnect(true); // true = also power the radio down
+        delay(100);
+        WiFi.mode(WIFI_STA);
+    }
+
     /**
      * Check for publish timeouts in a vector of components (sensors or actuators)
      * Returns true if ANY component has exceeded its timeout period
@@ -147,8 +158,8 @@ namespace FsmUtils {
     inline bool checkForNoPublishTimeouts(const std::vector<T*>& components) {
         for (const auto* component : components) {
             if (component->hasNoPublishTimeoutOccurred()) {
-                Serial.printf("TIMEOUT: %s has not published within timeout period\n", 
-                             component->getPointName());
+                LOG_ERROR("TIMEOUT: %s has not published within timeout period",
+                          component->getPointName());
                 return true; // First timeout found - fail fast
             }
         }
@@ -0,0 +1,268 @@
+#ifndef I2C_BUS_MANAGER_H
+#define I2C_BUS_MANAGER_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "Log.h"
+
+// Fast-mode ceiling. The bus runs at the slowest registered device's
+// declared capability (config i2c_max_clock_hz); a device that declares
+// nothing caps the bus at the conservative I2C_BUS_SAFE_CLOCK_HZ, so fast
+// mode only engages when every device on the bus is known to support it
+// (the SCD4x, for one, is specified at 100kHz max).
+#ifndef I2C_BUS_DEFAULT_CLOCK_HZ
+#define I2C_BUS_DEFAULT_CLOCK_HZ 400000UL
+#endif
+#ifndef I2C_BUS_SAFE_CLOCK_HZ
+#define I2C_BUS_SAFE_CLOCK_HZ 100000UL
+#endif
+
+/**
+ * @brief I2C bus manager: fast-mode clocking, stuck-bus recovery, stats
+ *
+ * Replaces the bare Wire.begin() at the default 100kHz with:
+ *  - 400kHz fast mode, derated to the slowest registered device's
+ *    capability (from the SensorConfigs.h i2c_max_clock_hz fields)
+ *  - stuck-bus detection (SDA held low by a wedged device) and the
+ *    standard clock-pulse recovery - up to 9 SCL pulses plus a STOP
+ *    condition - so one bad device no longer takes the whole bus down
+ *    until someone power-cycles the box
+ *  - per-device transaction timing and error counters (fed by the
+ *    periodic probe and by recordTransaction() hooks), readable for
+ *    diagnostics
+ */
+class I2cBusManager {
+public:
+    static const size_t MAX_TRACKED_DEVICES = 8;
+
+    struct DeviceStats {
+        uint8_t address;
+        uint32_t transactions;
+        uint32_t errors;
+        uint64_t totalUs;
+        uint32_t maxUs;
+    };
+
+private:
+    int _sdaPin;
+    int _sclPin;
+    uint32_t _clockHz;
+    DeviceStats _stats[MAX_TRACKED_DEVICES];
+    size_t _deviceCount;
+    uint32_t _recoveryCount;
+
+    DeviceStats* findOrAddDevice(uint8_t address) {
+        for (size_t i = 0; i < _deviceCount; i++) {
+            if (_stats[i].address == address) {
+                return &_stats[i];
+            }
+        }
+        if (_deviceCount >= MAX_TRACKED_DEVICES) {
+            return nullptr;
+        }
+        DeviceStats& slot = _stats[_deviceCount++];
+        slot.address = address;
+        slot.transactions = 0;
+        slot.errors = 0;
+        slot.totalUs = 0;
+        slot.maxUs = 0;
+        return &slot;
+    }
+
+public:
+    I2cBusManager()
+        : _sdaPin(-1),
+          _sclPin(-1),
+          _clockHz(I2C_BUS_DEFAULT_CLOCK_HZ),
+          _deviceCount(0),
+          _recoveryCount(0) {}
+
+    /**
+     * @brief Register a device before begin(); caps the bus clock
+     * @param address I2C address
+     * @param maxClockHz Device's declared max clock; 0 (no declared
+     *        capability) caps the bus at the conservative 100kHz default
+     *        rather than assuming fast-mode support
+     */
+    void registerDevice(uint8_t address, uint32_t maxClockHz) {
+        findOrAddDevice(address);
+        uint32_t effectiveCap = (maxClockHz > 0) ? maxClockHz : I2C_BUS_SAFE_CLOCK_HZ;
+        if (effectiveCap < _clockHz) {
+            _clockHz = effectiveCap;
+            LOG_INFO("I2cBusManager: bus clock capped to %lu Hz by device 0x%02X%s",
+                     static_cast<unsigned long>(effectiveCap), address,
+                     (maxClockHz == 0) ? " (no declared capability)" : "");
+        }
+    }
+
+    /**
+     * @brief Bring the bus up: recover if stuck, then begin at the
+     * negotiated clock. Call from SETUP_HW instead of Wire.begin().
+     */
+    bool begin(int sdaPin, int sclPin) {
+        _sdaPin = sdaPin;
+        _sclPin = sclPin;
+
+        // Pre-Wire: enable the pullup so the idle-level sample below is
+        // meaningful on a floating pin (safe - the bus isn't up yet)
+        pinMode(_sdaPin, INPUT_PULLUP);
+        delayMicroseconds(10);
+
+        if (isBusStuck()) {
+            LOG_WARN("I2cBusManager: bus stuck at startup - attempting recovery");
+            if (!recoverBus()) {
+                LOG_ERROR("I2cBusManager: bus recovery failed");
+                // Fall through and begin anyway - the scan/init will report
+            }
+        }
+
+        Wire.begin(_sdaPin, _sclPin);
+        Wire.setClock(_clockHz);
+        LOG_INFO("I2cBusManager: bus up on SDA:%d SCL:%d at %lu Hz",
+                 _sdaPin, _sclPin, static_cast<unsigned long>(_clockHz));
+        return true;
+    }
+
+    /**
+     * @brief True if SDA is held low with the bus idle (wedged device)
+     *
+     * Plain pad-level read: digitalRead() samples the GPIO input register
+     * without touching the pin's routing, so this is safe to call between
+     * transactions on a live bus (reconfiguring the pin with pinMode()
+     * here would detach it from the I2C peripheral).
+     */
+    bool isBusStuck() {
+        if (_sdaPin < 0) {
+            return false;
+        }
+        return digitalRead(_sdaPin) == LOW;
+    }
+
+    /**
+     * @brief Clock-pulse recovery: up to 9 SCL pulses to let the wedged
+     * device finish shifting its byte, then a STOP condition, then re-begin
+     * the bus. Sub-millisecond, vs. a power cycle.
+     * @return true if SDA released
+     */
+    bool recoverBus() {
+        if (_sdaPin < 0 || _sclPin < 0) {
+            return false;
+        }
+
+        Wire.end();
+        pinMode(_sdaPin, INPUT_PULLUP);
+        pinMode(_sclPin, OUTPUT);
+
+        // Up to 9 clock pulses: enough for a device mid-byte (8 bits + ACK)
+        for (int i = 0; i < 9 && digitalRead(_sdaPin) == LOW; i++) {
+            digitalWrite(_sclPin, LOW);
+            delayMicroseconds(5);
+            digitalWrite(_sclPin, HIGH);
+            delayMicroseconds(5);
+        }
+
+        bool released = (digitalRead(_sdaPin) == HIGH);
+        if (released) {
+            // Generate a STOP condition: SDA low -> high while SCL is high
+            pinMode(_sdaPin, OUTPUT);
+            digitalWrite(_sdaPin, LOW);
+            delayMicroseconds(5);
+            digitalWrite(_sclPin, HIGH);
+            delayMicroseconds(5);
+            digitalWrite(_sdaPin, HIGH);
+            delayMicroseconds(5);
+        }
+
+        // Hand the pins back to the I2C peripheral
+        Wire.begin(_sdaPin, _sclPin);
+        Wire.setClock(_clockHz);
+
+        _recoveryCount++;
+        if (released) {
+            LOG_WARN("I2cBusManager: bus recovered (recovery #%lu)",
+                     static_cast<unsigned long>(_recoveryCount));
+        } else {
+            LOG_ERROR("I2cBusManager: SDA still low after clock pulses");
+        }
+        return released;
+    }
+
+    /**
+     * @brief Timed probe of one device (empty transaction), fed into stats
+     */
+    bool probeDevice(uint8_t address) {
+        unsigned long start = micros();
+        Wire.beginTransmission(address);
+        byte error = Wire.endTransmission();
+        unsigned long duration = micros() - start;
+
+        recordTransaction(address, duration, error == 0);
+        return error == 0;
+    }
+
+    /**
+     * @brief Probe every registered device (periodic health check)
+     * @return Number of devices that answered
+     */
+    size_t probeRegisteredDevices() {
+        size_t responding = 0;
+        for (size_t i = 0; i < _deviceCount; i++) {
+            if (probeDevice(_stats[i].address)) {
+                responding++;
+            }
+        }
+        return responding;
+    }
+
+    /**
+     * @brief Fold one transaction into a device's counters
+     * (sensors doing their own Wire I/O can call this around transfers)
+     */
+    void recordTransaction(uint8_t address, unsigned long durationUs, bool success) {
+        DeviceStats* device = findOrAddDevice(address);
+        if (device == nullptr) {
+            return;
+        }
+        device->transactions++;
+        device->totalUs += durationUs;
+        if (durationUs > device->maxUs) {
+            device->maxUs = durationUs;
+        }
+        if (!success) {
+            device->errors++;
+        }
+    }
+
+    // Stats access for diagnostics/telemetry
+    const DeviceStats* getStats(size_t& count) const {
+        count = _deviceCount;
+        return _stats;
+    }
+
+    uint32_t getRecoveryCount() const {
+        return _recoveryCount;
+    }
+
+    uint32_t getClockHz() const {
+        return _clockHz;
+    }
+
+    /**
+     * @brief Log a one-line per-device summary (periodic checks)
+     */
+    void logStats() const {
+        for (size_t i = 0; i < _deviceCount; i++) {
+            const DeviceStats& device = _stats[i];
+            uint32_t avgUs = (device.transactions > 0)
+                ? static_cast<uint32_t>(device.totalUs / device.transactions) : 0;
+            LOG_INFO("I2C 0x%02X: %lu txns, %lu errs, avg %lu us, max %lu us",
+                     device.address,
+                     static_cast<unsigned long>(device.transactions),
+                     static_cast<unsigned long>(device.errors),
+                     static_cast<unsigned long>(avgUs),
+                     static_cast<unsigned long>(device.maxUs));
+        }
+    }
+};
+
+#endif // I2C_BUS_MANAGER_H
@@ -0,0 +1,119 @@
+#ifndef INTRUSIVE_UNIQUE_QUEUE_H
+#define INTRUSIVE_UNIQUE_QUEUE_H
+
+#include <stddef.h>
+
+/**
+ * @brief Heap-free intrusive variant of UniqueQueue
+ *
+ * UniqueQueue pairs a std::queue with a std::set, so every tryEnqueue from
+ * the per-loop checkSensorsNeedingRead() pays a red-black-tree node
+ * allocation plus a deque push. For a handful of statically known items
+ * that is pure overhead: this variant stores the membership bit in the item
+ * itself (via the IntrusiveQueueMember mixin) and keeps a fixed-capacity
+ * ring of pointers, giving O(1) enqueue/dequeue/contains with zero heap
+ * traffic and static storage.
+ *
+ * Used for g_sensorsToReadQueue on the sensor controllers; the actuator
+ * command queue on controller2 uses the same intrusive pattern inside
+ * ThreadSafeCommandQueue.
+ *
+ * @tparam T Item type; must derive from IntrusiveQueueMember
+ * @tparam Capacity Ring capacity (items are unique, so >= item count)
+ */
+
+template<typename T, size_t Capacity>
+class IntrusiveUniqueQueue;
+
+/**
+ * @brief Mixin carrying the queue-membership bit
+ * Derive the queued type from this (an item can be in one queue at a time).
+ */
+class IntrusiveQueueMember {
+private:
+    bool _inQueue;
+
+    template<typename T, size_t Capacity>
+    friend class IntrusiveUniqueQueue;
+
+public:
+    IntrusiveQueueMember() : _inQueue(false) {}
+
+    bool isQueued() const {
+        return _inQueue;
+    }
+};
+
+template<typename T, size_t Capacity>
+class IntrusiveUniqueQueue {
+private:
+    T* _slots[Capacity];
+    size_t _head;
+    size_t _count;
+
+public:
+    IntrusiveUniqueQueue() : _head(0), _count(0) {}
+
+    /**
+     * @brief Attempt to enqueue an item if not already present
+     * @return true if enqueued, false if already queued (or the ring is
+     *         full, which cannot happen when Capacity >= unique item count)
+     */
+    bool tryEnqueue(T* item) {
+        if (item->_inQueue || _count >= Capacity) {
+            return false;
+        }
+        _slots[(_head + _count) % Capacity] = item;
+        _count++;
+        item->_inQueue = true;
+        return true;
+    }
+
+    /**
+     * @brief Dequeue the front item and clear its membership bit
+     * @note Caller must check empty() before calling
+     */
+    T* dequeue() {
+        T* item = _slots[_head];
+        _head = (_head + 1) % Capacity;
+        _count--;
+        item->_inQueue = false;
+        return item;
+    }
+
+    bool empty() const {
+        return _count == 0;
+    }
+
+    size_t size() const {
+        return _count;
+    }
+
+    /**
+     * @brief O(1) membership check (reads the item's bit)
+     */
+    bool contains(const T* item) const {
+        return item->_inQueue;
+    }
+
+    /**
+     * @brief Item at FIFO position index (0 = front); for diagnostic walks
+     * @note Caller must ensure index < size()
+     */
+    T* itemAt(size_t index) const {
+        return _slots[(_head + index) % Capacity];
+    }
+
+    /**
+     * @brief Clear the queue and every member bit
+     */
+    void clear() {
+        for (size_t i = 0; i < _count; i++) {
+            _slots[(_head + i) % Capacity]->_inQueue = false;
+        }
+        _head = 0;
+        _count = 0;
+    }
+};
+
+#endif // INTRUSIVE_UNIQUE_QUEUE_H
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h> // We will use ArduinoJson for implementation
+#include "../PublishData.h" // For BatchReadingEntry (batched payloads)
 
 // Forward declaration for NtpService if its methods are directly used here
 // class NtpService; 
@@ -29,6 +30,60 @@ namespace JsonBuilder {
     String buildPayload(const String& timestamp_utc, const String& uuid, double value, int decimalPlaces = 2); // Often same as float on ESP32
     String buildPayload(const String& timestamp_utc, const String& uuid, bool value);
 
+    // === Zero-allocation payload path ===
+    // Buffer size for the fixed ADR-10 payload shape: keys/braces/quotes (~44)
+    // + timestamp (24) + UUID (36) + value. 160 leaves ~56 chars for the value,
+    // which is far beyond any sensor reading or status string we publish.
+    constexpr size_t MAX_PAYLOAD_SIZE = 160;
+
+    /**
+     * @brief Constructs the standard ADR-10 JSON payload into a caller-provided buffer.
+     *
+     * Produces byte-identical output to buildPayload() (compact ArduinoJson
+     * serialization: {"timestamp_utc":"<ts>","value":"<val>","uuid":"<uuid>"})
+     * but with zero heap allocation - a single snprintf into the buffer.
+     *
+     * NOTE: The value is emitted verbatim inside the JSON string. Our values
+     * are numbers, "on"/"off" and status slugs, so no JSON escaping is needed;
+     * do not pass values containing quotes or backslashes through this path.
+     *
+     * @param buffer Destination buffer (MAX_PAYLOAD_SIZE is always sufficient).
+     * @param bufferSize Size of the destination buffer.
+     * @param timestamp_utc The UTC timestamp string (e.g., from NtpService).
+     * @param uuid The UUID of the data point.
+     * @param value The value to include in the payload.
+     * @return size_t Length of the payload written, or 0 on failure
+     *         (missing timestamp/uuid, or buffer too small).
+     */
+    size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, const char* value);
+    size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, int value);
+    size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, float value, int decimalPlaces = 2);
+    size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, double value, int decimalPlaces = 2);
+    size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, bool value);
+
+    // Buffer size for batched payloads: skeleton (~40) + timestamp (24) +
+    // PUBLISH_BATCH_MAX_READINGS entries of {"uuid":"<36>","value":"<val>"}
+    // (~64 each incl. separators). 512 covers 4 entries with slack.
+    constexpr size_t MAX_BATCH_PAYLOAD_SIZE = 512;
+
+    /**
+     * @brief Constructs a batched multi-reading payload into a caller-provided buffer.
+     *
+     * Payload shape (one message per sensor read, shared timestamp):
+     * {"timestamp_utc":"<ts>","readings":[{"uuid":"<u>","value":"<v>"},...]}
+     *
+     * Zero heap allocation; same verbatim-value caveat as buildPayloadInto().
+     *
+     * @param buffer Destination buffer (MAX_BATCH_PAYLOAD_SIZE is always sufficient).
+     * @param bufferSize Size of the destination buffer.
+     * @param timestamp_utc The shared UTC timestamp string.
+     * @param entries Array of {uuid, value} entries.
+     * @param entryCount Number of entries (1..PUBLISH_BATCH_MAX_READINGS).
+     * @return size_t Length of the payload written, or 0 on failure.
+     */
+    size_t buildBatchPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc,
+                                 const BatchReadingEntry* entries, size_t entryCount);
+
 } // namespace JsonBuilder
 
 #endif // JSONBUILDER_H 
\ No newline at end of file
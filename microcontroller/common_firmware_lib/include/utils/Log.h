@@ -0,0 +1,96 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+
+/**
+ * @file Log.h
+ * @brief Compile-time leveled, ring-buffered async logging
+ *
+ * The hot paths were saturated with synchronous Serial.print at 115200 baud
+ * (~7ms per 80-char line - more than the I2C transaction being logged).
+ * This framework fixes that twice over:
+ *
+ *  - Compile-time level filtering: LOG_DEBUG/LOG_INFO sites below LOG_LEVEL
+ *    compile to nothing, so a production build (-D LOG_LEVEL=LOG_LEVEL_WARN)
+ *    has a print-free read/publish path with zero code-size cost.
+ *  - Async delivery: enabled sites format into a fixed ring buffer (a few
+ *    microseconds) and return; Log::drain() pushes buffered lines to Serial
+ *    in bounded slices from the loop tail, outside the FSM hot path.
+ *
+ * The ring is guarded by a portMUX critical section (cross-core safe for
+ * dual-core mode; the hold time is a short memcpy). When the ring is full,
+ * new lines are dropped and counted - diagnosability degrades gracefully
+ * instead of blocking the producer.
+ */
+
+// Levels (higher = more verbose)
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+// Default keeps today's verbosity; production builds override in build_flags,
+// e.g. -D LOG_LEVEL=LOG_LEVEL_WARN
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+// Ring capacity in bytes (override in build_flags)
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 2048
+#endif
+
+// Longest single formatted line (longer lines are truncated)
+#define LOG_MAX_LINE 128
+
+namespace Log {
+
+    /**
+     * @brief Format a line into the ring buffer (printf-style)
+     * @param level Single-char level tag ('E','W','I','D') prefixed to the line
+     * @param fmt printf format string
+     */
+    void writef(char level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Push buffered lines to Serial, bounded per call
+     * Call from the loop tail (never from the FSM hot path).
+     * @param maxBytes Max bytes to emit this call
+     */
+    void drain(size_t maxBytes = 256);
+
+    /**
+     * @brief Lines dropped because the ring was full (for telemetry)
+     */
+    uint32_t droppedLines();
+
+} // namespace Log
+
+// Level-gated logging macros. Disabled levels compile to nothing.
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Log::writef('E', __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) Log::writef('W', __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) Log::writef('I', __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Log::writef('D', __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+
+#endif // LOG_H
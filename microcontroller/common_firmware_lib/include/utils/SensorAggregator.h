@@ -0,0 +1,56 @@
+#ifndef SENSOR_AGGREGATOR_H
+#define SENSOR_AGGREGATOR_H
+
+#include <Arduino.h>
+#include <math.h>
+
+/**
+ * @brief Streaming mean accumulator (fixed-point, no allocation)
+ *
+ * Samples are folded in as centi-units (value * 100) in a 64-bit integer
+ * sum, so hundreds of samples per publish interval cost two integer ops
+ * each - no floating-point accumulation error growth, no allocation,
+ * constant RAM. The published aggregate is the mean; per-channel min/max
+ * were dropped because the SSOT defines no points/topics to publish them
+ * to (add them back alongside new points if that changes).
+ *
+ * One instance per published reading channel (temperature, humidity, ...);
+ * SensorPoint keeps a small fixed array of these for the oversampling mode.
+ */
+class StreamingAggregate {
+private:
+    int64_t _sumCenti;
+    uint32_t _count;
+
+public:
+    StreamingAggregate() {
+        reset();
+    }
+
+    void reset() {
+        _sumCenti = 0;
+        _count = 0;
+    }
+
+    void addSample(float value) {
+        _sumCenti += static_cast<int32_t>(lroundf(value * 100.0f));
+        _count++;
+    }
+
+    bool hasSamples() const {
+        return _count > 0;
+    }
+
+    uint32_t sampleCount() const {
+        return _count;
+    }
+
+    float mean() const {
+        if (_count == 0) {
+            return 0.0f;
+        }
+        return static_cast<float>(static_cast<double>(_sumCenti) / _count) / 100.0f;
+    }
+};
+
+#endif // SENSOR_AGGREGATOR_H
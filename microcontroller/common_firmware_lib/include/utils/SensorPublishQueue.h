@@ -1,91 +1,208 @@
 #ifndef SENSOR_PUBLISH_QUEUE_H
 #define SENSOR_PUBLISH_QUEUE_H
 
-#include <queue>
-#include <set>
+#include <Arduino.h>
+#include <string.h>
 #include "PublishData.h"
+#include "../sensors/SensorPoint.h"
+
+// Compile-time queue capacity. 32 slots covers several full read bursts plus
+// status messages; overflow drops the oldest record (counted). Override in
+// build_flags.
+#ifndef SENSOR_PUBLISH_QUEUE_CAPACITY
+#define SENSOR_PUBLISH_QUEUE_CAPACITY 32
+#endif
 
 /**
- * @brief Manages a publish queue with sensor tracking to prevent duplicate reads
- * 
- * This utility manages the common pattern of:
- * - std::queue<PublishData> for FIFO publishing
- * - std::set<SensorPoint*> for O(log N) duplicate checking
- * 
- * Ensures sensors aren't re-queued for reading when they already have data pending.
+ * @brief Fixed-capacity pooled publish queue with sensor tracking
+ *
+ * Replaces the previous std::queue<PublishData> (deque node allocations, two
+ * heap Strings copied per enqueue and again per dequeue) + std::set tracking
+ * with a compile-time-sized ring of pooled slots: topic/uuid stay pointers
+ * into flash, value and timestamp live in inline char arrays, and the
+ * pending-sensor check reads an intrusive flag on SensorPoint. Steady-state
+ * publishing touches the heap zero times and queue growth during broker
+ * outages has a hard RAM bound.
+ *
+ * Overflow policy: drop-oldest, with a counter the telemetry can report.
+ *
+ * The zero-copy path is peekFront()/popFront(); dequeueForPublish() remains
+ * for callers that need an owning PublishData copy (the flash spill path).
  */
 class SensorPublishQueue {
+public:
+    // Inline slot storage - field sizes fit our values ("75.23", ISO8601
+    // timestamp); longer strings are truncated on enqueue
+    struct Entry {
+        const char* topic;
+        const char* uuid;
+        char serializedValue[24];
+        char timestampIsoUtc[28];
+        SensorPoint* sourceSensor;
+        ActuatorControlPoint* sourceActuator;
+    };
+
 private:
-    std::queue<PublishData> _queue;
-    std::set<SensorPoint*> _sensorsWithPendingData;
+    Entry _slots[SENSOR_PUBLISH_QUEUE_CAPACITY];
+    size_t _head;               // Oldest slot
+    size_t _count;
+    uint32_t _droppedOldest;    // Overflow drops since boot
+
+    static void copyField(char* dest, size_t destSize, const char* src) {
+        if (src == nullptr) {
+            dest[0] = '\0';
+            return;
+        }
+        strncpy(dest, src, destSize - 1);
+        dest[destSize - 1] = '\0';
+    }
 
 public:
+    SensorPublishQueue() : _head(0), _count(0), _droppedOldest(0) {}
+
     /**
-     * @brief Add data to publish queue and track source sensor
-     * @param data The publish data to queue
+     * @brief Copy an item into the next slot and mark its sensor pending
+     * Drops the oldest slot (counted) when the ring is full.
      */
     void queueForPublish(const PublishData& data) {
-        _queue.push(data);
+        if (_count >= SENSOR_PUBLISH_QUEUE_CAPACITY) {
+            // Overflow: drop the oldest record to make room
+            Entry& oldest = _slots[_head];
+            if (oldest.sourceSensor != nullptr) {
+                oldest.sourceSensor->setPublishPending(false);
+            }
+            _head = (_head + 1) % SENSOR_PUBLISH_QUEUE_CAPACITY;
+            _count--;
+            _droppedOldest++;
+        }
+
+        Entry& slot = _slots[(_head + _count) % SENSOR_PUBLISH_QUEUE_CAPACITY];
+        slot.topic = data.topic;
+        slot.uuid = data.uuid;
+        copyField(slot.serializedValue, sizeof(slot.serializedValue), data.serializedValue.c_str());
+        copyField(slot.timestampIsoUtc, sizeof(slot.timestampIsoUtc), data.timestampIsoUtc.c_str());
+        slot.sourceSensor = data.sourceSensor;
+        slot.sourceActuator = data.sourceActuator;
+        _count++;
+
         if (data.sourceSensor != nullptr) {
-            _sensorsWithPendingData.insert(data.sourceSensor);
+            data.sourceSensor->setPublishPending(true);
+        }
+    }
+
+    /**
+     * @brief Allocation-free enqueue: format the numeric reading straight
+     * into the slot (no PublishData, no Strings anywhere on the path)
+     */
+    void queueReading(const char* topic, const char* uuid, float value, uint8_t decimals,
+                      const char* timestamp, SensorPoint* sensor) {
+        if (_count >= SENSOR_PUBLISH_QUEUE_CAPACITY) {
+            // Overflow: drop the oldest record to make room
+            Entry& oldest = _slots[_head];
+            if (oldest.sourceSensor != nullptr) {
+                oldest.sourceSensor->setPublishPending(false);
+            }
+            _head = (_head + 1) % SENSOR_PUBLISH_QUEUE_CAPACITY;
+            _count--;
+            _droppedOldest++;
+        }
+
+        Entry& slot = _slots[(_head + _count) % SENSOR_PUBLISH_QUEUE_CAPACITY];
+        slot.topic = topic;
+        slot.uuid = uuid;
+        dtostrf(value, 0, decimals, slot.serializedValue);
+        copyField(slot.timestampIsoUtc, sizeof(slot.timestampIsoUtc), timestamp);
+        slot.sourceSensor = sensor;
+        slot.sourceActuator = nullptr;
+        _count++;
+
+        if (sensor != nullptr) {
+            sensor->setPublishPending(true);
         }
     }
 
     /**
-     * @brief Remove and return front item from queue
-     * @return The front PublishData item
+     * @brief Zero-copy view of the front slot (nullptr if empty)
+     * Valid until the next popFront()/queueForPublish().
+     */
+    const Entry* peekFront() const {
+        return (_count > 0) ? &_slots[_head] : nullptr;
+    }
+
+    /**
+     * @brief Discard the front slot
+     * @note Caller must check empty() before calling
+     */
+    void popFront() {
+        _head = (_head + 1) % SENSOR_PUBLISH_QUEUE_CAPACITY;
+        _count--;
+    }
+
+    /**
+     * @brief Remove and return an owning copy of the front item
+     * (allocating path - used by the flash spill; publishing uses peekFront)
      * @note Caller must check empty() before calling
      */
     PublishData dequeueForPublish() {
-        PublishData item = _queue.front();
-        _queue.pop();
+        const Entry& slot = _slots[_head];
+        PublishData item(slot.topic, slot.uuid,
+                         String(slot.serializedValue), String(slot.timestampIsoUtc));
+        item.sourceSensor = slot.sourceSensor;
+        item.sourceActuator = slot.sourceActuator;
+        popFront();
         return item;
     }
 
     /**
-     * @brief Mark publish as complete and remove sensor from tracking
-     * @param item The published item
+     * @brief Mark publish as complete and clear the sensor's pending flag
      */
     void markPublishComplete(const PublishData& item) {
         if (item.sourceSensor != nullptr) {
-            _sensorsWithPendingData.erase(item.sourceSensor);
+            item.sourceSensor->setPublishPending(false);
+        }
+    }
+
+    void markPublishComplete(const Entry& entry) {
+        if (entry.sourceSensor != nullptr) {
+            entry.sourceSensor->setPublishPending(false);
         }
     }
 
     /**
-     * @brief Check if sensor has pending data in queue
-     * @param sensor The sensor to check
-     * @return true if sensor has data pending
+     * @brief Check if sensor has pending data in queue (intrusive flag read)
      */
     bool hasPendingData(SensorPoint* sensor) const {
-        return _sensorsWithPendingData.find(sensor) != _sensorsWithPendingData.end();
+        return sensor->hasPublishPending();
     }
 
-    /**
-     * @brief Check if queue is empty
-     * @return true if queue is empty
-     */
     bool empty() const {
-        return _queue.empty();
+        return _count == 0;
+    }
+
+    size_t size() const {
+        return _count;
     }
 
     /**
-     * @brief Get number of items in queue
-     * @return Queue size
+     * @brief Records dropped by the overflow policy (for telemetry)
      */
-    size_t size() const {
-        return _queue.size();
+    uint32_t droppedCount() const {
+        return _droppedOldest;
     }
 
     /**
-     * @brief Clear all items from queue and tracking set
+     * @brief Clear all slots and pending flags
      */
     void clear() {
-        while (!_queue.empty()) {
-            _queue.pop();
+        for (size_t i = 0; i < _count; i++) {
+            Entry& slot = _slots[(_head + i) % SENSOR_PUBLISH_QUEUE_CAPACITY];
+            if (slot.sourceSensor != nullptr) {
+                slot.sourceSensor->setPublishPending(false);
+            }
         }
-        _sensorsWithPendingData.clear();
+        _head = 0;
+        _count = 0;
     }
 };
 
-#endif // SENSOR_PUBLISH_QUEUE_H 
\ No newline at end of file
+#endif // SENSOR_PUBLISH_QUEUE_H
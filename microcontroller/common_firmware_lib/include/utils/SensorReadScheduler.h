@@ -0,0 +1,111 @@
+#ifndef SENSOR_READ_SCHEDULER_H
+#define SENSOR_READ_SCHEDULER_H
+
+#include "../sensors/SensorPoint.h"
+
+/**
+ * @brief Pipelined scheduler for two-phase sensor reads
+ *
+ * Tracks every sensor with a conversion in flight so READ_SENSORS can start
+ * conversions on multiple independent buses concurrently (a DS18B20's ~750ms
+ * OneWire conversion overlaps entirely with I2C transactions and the DHT22)
+ * and collect each result as its ready deadline passes. The read burst for a
+ * multi-sensor controller shrinks from the sum of conversion times to
+ * roughly the max of them, which also tightens timestamp alignment between
+ * readings taken in the same burst.
+ *
+ * Bus safety: all actual bus traffic happens inside startRead()/finishRead()
+ * calls, which the single-threaded FSM serializes - only the in-device
+ * conversions overlap - so no per-bus arbitration is needed.
+ *
+ * Fixed-capacity, no heap; sized for more sensors than any controller has.
+ */
+class SensorReadScheduler {
+public:
+    static const size_t MAX_IN_FLIGHT = 8;
+
+private:
+    SensorPoint* _inFlight[MAX_IN_FLIGHT];
+    size_t _count;
+
+public:
+    SensorReadScheduler() : _count(0) {
+        for (size_t i = 0; i < MAX_IN_FLIGHT; i++) {
+            _inFlight[i] = nullptr;
+        }
+    }
+
+    /**
+     * @brief Track a sensor whose startRead() just succeeded
+     * @return false if the scheduler is full (sensor stays untracked)
+     */
+    bool track(SensorPoint* sensor) {
+        if (_count >= MAX_IN_FLIGHT) {
+            return false;
+        }
+        _inFlight[_count++] = sensor;
+        return true;
+    }
+
+    // True if another conversion can be started
+    bool hasCapacity() const {
+        return _count < MAX_IN_FLIGHT;
+    }
+
+    // True while any conversion is in flight
+    bool hasInFlight() const {
+        return _count > 0;
+    }
+
+    // Number of conversions in flight
+    size_t count() const {
+        return _count;
+    }
+
+    /**
+     * @brief True if any in-flight conversion is ready to collect
+     */
+    bool anyReady(unsigned long currentTimeMs) const {
+        for (size_t i = 0; i < _count; i++) {
+            if (_inFlight[i]->isReadReady(currentTimeMs)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Remove and return the first ready sensor, or nullptr
+     * Caller follows up with finishRead().
+     */
+    SensorPoint* takeReady(unsigned long currentTimeMs) {
+        for (size_t i = 0; i < _count; i++) {
+            if (_inFlight[i]->isReadReady(currentTimeMs)) {
+                SensorPoint* sensor = _inFlight[i];
+                // Swap-remove keeps the array dense
+                _inFlight[i] = _inFlight[_count - 1];
+                _inFlight[_count - 1] = nullptr;
+                _count--;
+                return sensor;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Milliseconds until the earliest in-flight conversion is ready
+     * (0 if one is ready now; ULONG_MAX if nothing is in flight)
+     */
+    unsigned long earliestReadyRemainingMs(unsigned long currentTimeMs) const {
+        unsigned long earliest = ULONG_MAX;
+        for (size_t i = 0; i < _count; i++) {
+            unsigned long remaining = _inFlight[i]->readReadyRemainingMs(currentTimeMs);
+            if (remaining < earliest) {
+                earliest = remaining;
+            }
+        }
+        return earliest;
+    }
+};
+
+#endif // SENSOR_READ_SCHEDULER_H
@@ -0,0 +1,99 @@
+#ifndef STATIC_SENSOR_REGISTRY_H
+#define STATIC_SENSOR_REGISTRY_H
+
+#include <tuple>
+#include <type_traits>
+#include "../sensors/SensorPoint.h"
+
+/**
+ * @brief Compile-time sensor registry with static storage and dispatch
+ *
+ * The sensor set of every controller is fully known at build time (it comes
+ * from the generated autogen_config.h structs), so there is no reason to
+ * `new` sensor points into a vector and pay vtable dispatch on every hot-path
+ * call. This registry instantiates the sensor points as direct members of a
+ * std::tuple - no heap allocation, deterministic RAM accounting in the .bss
+ * image - and iterates them with compile-time recursion, so calls made
+ * through forEach() are statically dispatched (and inlinable).
+ *
+ * Code that still works with SensorPoint* (the read queue, the publish
+ * queue's pending-sensor tracking) can get a pointer view via
+ * fillPointerArray() without any per-sensor heap allocation.
+ *
+ * NOTE: visitors are plain structs with a template operator() rather than
+ * generic lambdas because the Arduino ESP32 toolchain compiles gnu++11.
+ *
+ * Usage:
+ *   StaticSensorRegistry<SHT85SensorPoint, BME280SensorPoint>
+ *       g_sensorRegistry(SHT85_0_CONFIG, BME280_1_CONFIG);
+ *
+ * @tparam SensorTypes The concrete sensor point types, in order
+ */
+template<typename... SensorTypes>
+class StaticSensorRegistry {
+private:
+    // Each element is direct-initialized from its corresponding config
+    // argument - the sensors are constructed in place, never copied
+    std::tuple<SensorTypes...> _sensors;
+
+public:
+    template<typename... Configs>
+    explicit StaticSensorRegistry(const Configs&... configs)
+        : _sensors(configs...) {}
+
+    /**
+     * @brief Number of sensors in the registry (compile-time constant)
+     */
+    static constexpr size_t size() {
+        return sizeof...(SensorTypes);
+    }
+
+    /**
+     * @brief Visit every sensor with compile-time dispatch
+     *
+     * The visitor's operator() is instantiated per concrete sensor type, so
+     * calls inside it (initialize(), needToRead(), ...) bypass the vtable.
+     *
+     * @param visitor Struct with a template operator()(SensorT&)
+     */
+    template<size_t I = 0, typename Visitor>
+    typename std::enable_if<I == sizeof...(SensorTypes)>::type
+    forEach(Visitor& visitor) {
+        (void)visitor; // All sensors visited
+    }
+
+    template<size_t I = 0, typename Visitor>
+    typename std::enable_if<I < sizeof...(SensorTypes)>::type
+    forEach(Visitor& visitor) {
+        visitor(std::get<I>(_sensors));
+        forEach<I + 1>(visitor);
+    }
+
+    /**
+     * @brief Fill an array with SensorPoint* views of the registered sensors
+     *
+     * For code that still operates on the base-class interface (read queue,
+     * publish tracking). The array must hold at least size() entries.
+     *
+     * @param out Destination array of SensorPoint pointers
+     */
+    void fillPointerArray(SensorPoint** out) {
+        PointerFillVisitor visitor(out);
+        forEach(visitor);
+    }
+
+private:
+    struct PointerFillVisitor {
+        SensorPoint** out;
+        size_t index;
+
+        explicit PointerFillVisitor(SensorPoint** out) : out(out), index(0) {}
+
+        template<typename SensorT>
+        void operator()(SensorT& sensor) {
+            out[index++] = &sensor;
+        }
+    };
+};
+
+#endif // STATIC_SENSOR_REGISTRY_H
@@ -0,0 +1,115 @@
+#ifndef THREAD_SAFE_COMMAND_QUEUE_H
+#define THREAD_SAFE_COMMAND_QUEUE_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <map>
+#include "IntrusiveUniqueQueue.h"
+#include "../actuators/ActuatorControlPoint.h"
+
+// Ring capacity: actuators are unique in the queue, so this just needs to
+// be >= the controller's actuator count. Override in build_flags.
+#ifndef COMMAND_QUEUE_CAPACITY
+#define COMMAND_QUEUE_CAPACITY 8
+#endif
+
+/**
+ * @brief Thread-safe actuator command queue with "latest wins" semantics
+ *
+ * Mutex-guarded so the MQTT callback can run on core 0 (NetworkTask) while
+ * the FSM drains commands on core 1. Internally heap-free: the process
+ * queue is an IntrusiveUniqueQueue (membership bit on ActuatorControlPoint,
+ * fixed ring of pointers) and the pending payload lives in a small inline
+ * buffer on the actuator itself - no std::map/queue/set nodes.
+ *
+ * "Latest wins" logic (ADR-22): if an actuator already has a pending
+ * command, a new command overwrites the payload in place without
+ * re-queueing the actuator.
+ */
+class ThreadSafeCommandQueue {
+private:
+    IntrusiveUniqueQueue<ActuatorControlPoint, COMMAND_QUEUE_CAPACITY> _processQueue;
+    SemaphoreHandle_t _mutex;
+
+public:
+    ThreadSafeCommandQueue() {
+        _mutex = xSemaphoreCreateMutex();
+    }
+
+    /**
+     * @brief Queue a command for an actuator (latest wins)
+     * @param actuator The target actuator
+     * @param payload The command payload ("on"/"off")
+     * @return true if the actuator was newly queued, false if an existing
+     *         pending command was replaced
+     */
+    bool queueCommand(ActuatorControlPoint* actuator, const String& payload) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+
+        strncpy(actuator->_pendingCommand, payload.c_str(), sizeof(actuator->_pendingCommand) - 1);
+        actuator->_pendingCommand[sizeof(actuator->_pendingCommand) - 1] = '\0';
+
+        bool newlyQueued = _processQueue.tryEnqueue(actuator);
+
+        xSemaphoreGive(_mutex);
+        return newlyQueued;
+    }
+
+    /**
+     * @brief Dequeue the next actuator and its latest pending command
+     * @param actuator Receives the actuator to process
+     * @param payload Receives the latest pending payload for that actuator
+     * @return true if a command was dequeued, false if the queue was empty
+     */
+    bool dequeueCommand(ActuatorControlPoint*& actuator, String& payload) {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+
+        if (_processQueue.empty()) {
+            xSemaphoreGive(_mutex);
+            return false;
+        }
+
+        actuator = _processQueue.dequeue();
+        payload = actuator->_pendingCommand;
+
+        xSemaphoreGive(_mutex);
+        return true;
+    }
+
+    /**
+     * @brief Check if any commands are waiting to be processed
+     */
+    bool empty() const {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        bool result = _processQueue.empty();
+        xSemaphoreGive(_mutex);
+        return result;
+    }
+
+    /**
+     * @brief Get number of actuators waiting to be processed
+     */
+    size_t size() const {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        size_t result = _processQueue.size();
+        xSemaphoreGive(_mutex);
+        return result;
+    }
+
+    /**
+     * @brief Copy the pending commands (for debug printing only - this
+     * path allocates, the queue itself never does)
+     * @param out Receives a snapshot of actuator -> pending payload
+     */
+    void snapshotPendingCommands(std::map<ActuatorControlPoint*, String>& out) const {
+        xSemaphoreTake(_mutex, portMAX_DELAY);
+        for (size_t i = 0; i < _processQueue.size(); i++) {
+            ActuatorControlPoint* actuator = _processQueue.itemAt(i);
+            out[actuator] = String(actuator->_pendingCommand);
+        }
+        xSemaphoreGive(_mutex);
+    }
+};
+
+#endif // THREAD_SAFE_COMMAND_QUEUE_H
@@ -0,0 +1,64 @@
+#ifndef TOPIC_DISPATCH_TABLE_H
+#define TOPIC_DISPATCH_TABLE_H
+
+#include <Arduino.h>
+
+// Forward declaration to avoid circular includes
+class ActuatorControlPoint;
+
+/**
+ * @file TopicDispatchTable.h
+ * @brief Hash-based inbound topic -> actuator dispatch
+ *
+ * Replaces the std::map<String, ActuatorControlPoint*> command routing: the
+ * complete topic set is known at build time (it comes from the generated
+ * autogen_config.h structs), so controllers declare a const table of
+ * {hash, topic, actuator} entries once and inbound dispatch becomes one
+ * FNV-1a hash of the incoming topic plus a uint32 compare per entry and a
+ * single confirming strcmp on the match - no String construction, no
+ * red-black-tree walk, no heap nodes.
+ *
+ * The hash function is constexpr so literal topics hash at compile time;
+ * table entries built from the config structs hash once during static init.
+ */
+
+struct TopicDispatchEntry {
+    uint32_t hash;              // FNV-1a of the topic
+    const char* topic;          // For the confirming compare (collision guard)
+    ActuatorControlPoint* actuator;
+};
+
+namespace TopicDispatch {
+
+    // FNV-1a 32-bit. Single-return recursion keeps it constexpr under the
+    // gnu++11 the Arduino ESP32 toolchain compiles with.
+    constexpr uint32_t hash(const char* s, uint32_t h = 2166136261u) {
+        return (*s == '\0')
+            ? h
+            : hash(s + 1, (h ^ static_cast<uint32_t>(static_cast<unsigned char>(*s))) * 16777619u);
+    }
+
+    /**
+     * @brief Look up the actuator for an inbound topic
+     * @param entries The controller's dispatch table
+     * @param count Number of table entries
+     * @param topic NUL-terminated inbound topic from the MQTT callback
+     * @return The matching actuator, or nullptr if no entry matches
+     */
+    inline ActuatorControlPoint* lookup(const TopicDispatchEntry* entries, size_t count, const char* topic) {
+        if (entries == nullptr || topic == nullptr) {
+            return nullptr;
+        }
+
+        uint32_t topicHash = hash(topic);
+        for (size_t i = 0; i < count; i++) {
+            if (entries[i].hash == topicHash && strcmp(entries[i].topic, topic) == 0) {
+                return entries[i].actuator;
+            }
+        }
+        return nullptr;
+    }
+
+} // namespace TopicDispatch
+
+#endif // TOPIC_DISPATCH_TABLE_H
@@ -10,10 +10,17 @@ ActuatorControlPoint::ActuatorControlPoint(const ActuatorConfig& config)
       _readbackUUID(config.readback_uuid),
       _outputRepublishFrequencyMillis(config.republish_frequency_ms),
       _maxTimeNoPublishMillis(config.max_time_no_publish_ms),
+      _covHeartbeatMillis(config.cov_heartbeat_ms),
       _lastPublishTimeMillis(0),                  // Initialize to 0
-      _lastSuccessfulPayload("")                  // Initialize to empty string
+      _criticalFastPath(config.critical_fast_path != 0),
+      _fastPathReadbackPending(false),
+      _commandReceiptUs(0),
+      _commandLatencyCount(0),
+      _commandLatencyMaxUs(0),
+      _commandLatencyTotalUs(0)
 {
-    // Constructor initialization complete via member initializer list
+    _pendingCommand[0] = '\0';
+    _lastSuccessfulPayload[0] = '\0';
 }
 
 void ActuatorControlPoint::initialize() {
@@ -121,11 +128,26 @@ unsigned long ActuatorControlPoint::getLastPublishTimeMillis() const {
 bool ActuatorControlPoint::isTimeToRepublish() const {
     // Simple method for FSM to check if it's time to republish this actuator's readback
     // Returns true if (millis() - _lastPublishTimeMillis >= _outputRepublishFrequencyMillis)
-    
+    //
+    // CoV mode (cov_heartbeat_ms > 0): state *changes* already publish
+    // immediately through the command/readback flow, so the unchanged-state
+    // re-announce only needs to run at the slow heartbeat for liveness
+    // instead of every republish period.
+
     unsigned long currentTime = millis();
     unsigned long timeSinceLastPublish = currentTime - _lastPublishTimeMillis;
-    
-    return timeSinceLastPublish >= _outputRepublishFrequencyMillis;
+
+    unsigned long republishPeriod = (_covHeartbeatMillis > 0)
+        ? _covHeartbeatMillis
+        : _outputRepublishFrequencyMillis;
+
+    // Keep the heartbeat safely inside the no-publish watchdog window - a
+    // heartbeat at or past the window would guarantee a NOPUBLISH restart
+    if (_maxTimeNoPublishMillis > 0 && republishPeriod > _maxTimeNoPublishMillis / 2) {
+        republishPeriod = _maxTimeNoPublishMillis / 2;
+    }
+
+    return timeSinceLastPublish >= republishPeriod;
 }
 
 bool ActuatorControlPoint::hasNoPublishTimeoutOccurred() const {
@@ -144,13 +166,64 @@ bool ActuatorControlPoint::hasNoPublishTimeoutOccurred() const {
 }
 
 bool ActuatorControlPoint::isLastStateSet() const {
-    return !_lastSuccessfulPayload.isEmpty();
+    return _lastSuccessfulPayload[0] != '\0';
 }
 
 String ActuatorControlPoint::getLastSuccessfulPayload() const {
-    return _lastSuccessfulPayload;
+    return String(_lastSuccessfulPayload);
 }
 
 void ActuatorControlPoint::setLastSuccessfulPayload(const String& payload) {
-    _lastSuccessfulPayload = payload;
+    // Bounded copy into the fixed buffer - writable from the MQTT callback
+    // core without a String reallocation racing the FSM core's reads
+    strncpy(_lastSuccessfulPayload, payload.c_str(), sizeof(_lastSuccessfulPayload) - 1);
+    _lastSuccessfulPayload[sizeof(_lastSuccessfulPayload) - 1] = '\0';
+}
+
+// === Command fast path and latency instrumentation ===
+
+bool ActuatorControlPoint::isCriticalFastPath() const {
+    return _criticalFastPath;
+}
+
+void ActuatorControlPoint::setFastPathReadbackPending(bool pending) {
+    _fastPathReadbackPending = pending;
+}
+
+bool ActuatorControlPoint::hasFastPathReadbackPending() const {
+    return _fastPathReadbackPending;
+}
+
+void ActuatorControlPoint::markCommandReceived() {
+    _commandReceiptUs = micros();
+}
+
+void ActuatorControlPoint::recordCommandExecuted() {
+    if (_commandReceiptUs == 0) {
+        return; // No receipt stamp (e.g. the initial-state command at boot)
+    }
+
+    unsigned long latencyUs = micros() - _commandReceiptUs;
+    _commandReceiptUs = 0;
+
+    _commandLatencyCount++;
+    _commandLatencyTotalUs += latencyUs;
+    if (latencyUs > _commandLatencyMaxUs) {
+        _commandLatencyMaxUs = latencyUs;
+    }
+}
+
+uint32_t ActuatorControlPoint::getCommandLatencyCount() const {
+    return _commandLatencyCount;
+}
+
+uint32_t ActuatorControlPoint::getCommandLatencyAvgUs() const {
+    if (_commandLatencyCount == 0) {
+        return 0;
+    }
+    return static_cast<uint32_t>(_commandLatencyTotalUs / _commandLatencyCount);
+}
+
+uint32_t ActuatorControlPoint::getCommandLatencyMaxUs() const {
+    return _commandLatencyMaxUs;
 } 
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "services/DeepSleepScheduler.h"
+#include "services/NtpService.h"
+#include <esp_sleep.h>
+#include <sys/time.h>
+
+// Carryover block in RTC slow memory - survives deep sleep, lost on power-off
+namespace {
+    const uint32_t SLEEP_STATE_MAGIC = 0x534C5030; // "SLP0"
+
+    struct SleepCarryoverState {
+        uint32_t magic;
+        uint64_t epochAtSleep;      // Seconds since epoch when we went to sleep
+        uint64_t sleepDurationMs;   // How long the timer was set for
+    };
+
+    RTC_DATA_ATTR SleepCarryoverState g_sleepState;
+}
+
+bool DeepSleepScheduler::isTimerWake() {
+    return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER &&
+           g_sleepState.magic == SLEEP_STATE_MAGIC;
+}
+
+bool DeepSleepScheduler::restoreCarriedTime() {
+    if (!isTimerWake() || g_sleepState.epochAtSleep == 0) {
+        return false;
+    }
+
+    struct timeval tv;
+    tv.tv_sec = static_cast<time_t>(g_sleepState.epochAtSleep + g_sleepState.sleepDurationMs / 1000);
+    tv.tv_usec = 0;
+    settimeofday(&tv, NULL);
+
+    Serial.print("DeepSleepScheduler: carried time restored, epoch now ");
+    Serial.println(static_cast<unsigned long>(tv.tv_sec));
+    return true;
+}
+
+unsigned long DeepSleepScheduler::computeSleepDurationMs(const std::vector<SensorPoint*>& sensors) {
+    unsigned long currentTime = millis();
+    unsigned long earliest = ULONG_MAX;
+
+    for (const SensorPoint* sensor : sensors) {
+        unsigned long untilNext = sensor->timeUntilNextReadMs(currentTime);
+        if (untilNext < earliest) {
+            earliest = untilNext;
+        }
+    }
+
+    if (earliest == ULONG_MAX || earliest <= DEEP_SLEEP_WAKE_MARGIN_MS) {
+        return 0; // A sensor is due now (or will be before we could reconnect)
+    }
+    return earliest - DEEP_SLEEP_WAKE_MARGIN_MS;
+}
+
+void DeepSleepScheduler::enterDeepSleep(unsigned long durationMs, NtpService& ntp) {
+    g_sleepState.magic = SLEEP_STATE_MAGIC;
+    g_sleepState.epochAtSleep = ntp.isTimeSet() ? ntp.getEpochTime() : 0;
+    g_sleepState.sleepDurationMs = durationMs;
+
+    Serial.print("DeepSleepScheduler: sleeping for ");
+    Serial.print(durationMs);
+    Serial.println(" ms");
+    Serial.flush();
+
+    esp_sleep_enable_timer_wakeup(static_cast<uint64_t>(durationMs) * 1000ULL);
+    esp_deep_sleep_start();
+    // Never reached
+}
@@ -62,4 +62,106 @@ String buildPayload(const String& timestamp_utc, const String& uuid, bool value)
     return buildPayload(timestamp_utc, uuid, value ? "true" : "false");
 }
 
+// === Zero-allocation payload path ===
+
+// Base function for the caller-buffer path. No heap traffic: one snprintf
+// with the known ADR-10 shape. Output matches buildPayload() byte-for-byte.
+size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, const char* value) {
+    if (buffer == nullptr || bufferSize == 0) {
+        return 0;
+    }
+
+    // Same validation as buildPayload(), minus the error-JSON allocation -
+    // the caller gets 0 and decides what to log.
+    if (timestamp_utc == nullptr || timestamp_utc[0] == '\0') {
+        return 0;
+    }
+    if (uuid == nullptr || uuid[0] == '\0') {
+        return 0;
+    }
+    if (value == nullptr) {
+        return 0;
+    }
+
+    int written = snprintf(buffer, bufferSize,
+                           "{\"timestamp_utc\":\"%s\",\"value\":\"%s\",\"uuid\":\"%s\"}",
+                           timestamp_utc, value, uuid);
+
+    if (written <= 0 || static_cast<size_t>(written) >= bufferSize) {
+        // Encoding error or truncation - never publish a truncated payload
+        return 0;
+    }
+    return static_cast<size_t>(written);
+}
+
+size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, int value) {
+    char valueBuffer[12]; // Enough for a 32-bit integer string + null terminator
+    sprintf(valueBuffer, "%d", value);
+    return buildPayloadInto(buffer, bufferSize, timestamp_utc, uuid, valueBuffer);
+}
+
+size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, float value, int decimalPlaces) {
+    char valueBuffer[32]; // Generous buffer for float string
+    dtostrf(value, 0, decimalPlaces, valueBuffer);
+    return buildPayloadInto(buffer, bufferSize, timestamp_utc, uuid, valueBuffer);
+}
+
+size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, double value, int decimalPlaces) {
+    // On ESP32, double is typically the same as float (32-bit)
+    return buildPayloadInto(buffer, bufferSize, timestamp_utc, uuid, static_cast<float>(value), decimalPlaces);
+}
+
+size_t buildPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc, const char* uuid, bool value) {
+    return buildPayloadInto(buffer, bufferSize, timestamp_utc, uuid, value ? "true" : "false");
+}
+
+// === Batched payload path ===
+
+size_t buildBatchPayloadInto(char* buffer, size_t bufferSize, const char* timestamp_utc,
+                             const BatchReadingEntry* entries, size_t entryCount) {
+    if (buffer == nullptr || bufferSize == 0) {
+        return 0;
+    }
+    if (timestamp_utc == nullptr || timestamp_utc[0] == '\0') {
+        return 0;
+    }
+    if (entries == nullptr || entryCount == 0 || entryCount > PUBLISH_BATCH_MAX_READINGS) {
+        return 0;
+    }
+
+    // Opening: {"timestamp_utc":"<ts>","readings":[
+    int written = snprintf(buffer, bufferSize,
+                           "{\"timestamp_utc\":\"%s\",\"readings\":[",
+                           timestamp_utc);
+    if (written <= 0 || static_cast<size_t>(written) >= bufferSize) {
+        return 0;
+    }
+    size_t offset = static_cast<size_t>(written);
+
+    // One {"uuid":"<u>","value":"<v>"} object per entry
+    for (size_t i = 0; i < entryCount; i++) {
+        if (entries[i].uuid == nullptr) {
+            return 0;
+        }
+        written = snprintf(buffer + offset, bufferSize - offset,
+                           "%s{\"uuid\":\"%s\",\"value\":\"%s\"}",
+                           (i == 0) ? "" : ",",
+                           entries[i].uuid, entries[i].serializedValue.c_str());
+        if (written <= 0 || static_cast<size_t>(written) >= bufferSize - offset) {
+            // Truncation - never publish a partial batch
+            return 0;
+        }
+        offset += static_cast<size_t>(written);
+    }
+
+    // Closing: ]}
+    written = snprintf(buffer + offset, bufferSize - offset, "]}");
+    if (written <= 0 || static_cast<size_t>(written) >= bufferSize - offset) {
+        return 0;
+    }
+    offset += static_cast<size_t>(written);
+
+    return offset;
+}
+
 } // namespace JsonBuilder 
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "utils/Log.h"
+#include <stdarg.h>
+
+namespace {
+    // Byte ring: each entry is a length byte followed by the line bytes.
+    // Guarded by a portMUX critical section (short memcpy hold times only).
+    char g_ring[LOG_RING_SIZE];
+    volatile size_t g_head = 0;      // Oldest byte
+    volatile size_t g_tail = 0;      // Next free byte
+    volatile size_t g_used = 0;      // Bytes in use
+    volatile uint32_t g_dropped = 0; // Lines dropped (ring full)
+
+    portMUX_TYPE g_ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+    void ringPutBytes(const char* data, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            g_ring[g_tail] = data[i];
+            g_tail = (g_tail + 1) % LOG_RING_SIZE;
+        }
+        g_used += length;
+    }
+}
+
+namespace Log {
+
+void writef(char level, const char* fmt, ...) {
+    // Format on the producer's stack: "[X] <message>\n"
+    char line[LOG_MAX_LINE];
+    line[0] = '[';
+    line[1] = level;
+    line[2] = ']';
+    line[3] = ' ';
+
+    va_list args;
+    va_start(args, fmt);
+    int formatted = vsnprintf(line + 4, sizeof(line) - 5, fmt, args);
+    va_end(args);
+
+    if (formatted < 0) {
+        return;
+    }
+    size_t lineLen = 4 + ((static_cast<size_t>(formatted) < sizeof(line) - 5)
+                              ? static_cast<size_t>(formatted)
+                              : sizeof(line) - 5);
+    line[lineLen++] = '\n';
+
+    taskENTER_CRITICAL(&g_ringMux);
+    // +1 for the length byte
+    if (g_used + lineLen + 1 > LOG_RING_SIZE) {
+        g_dropped = g_dropped + 1; // Ring full - drop, never block the producer
+    } else {
+        char lenByte = static_cast<char>(lineLen);
+        ringPutBytes(&lenByte, 1);
+        ringPutBytes(line, lineLen);
+    }
+    taskEXIT_CRITICAL(&g_ringMux);
+}
+
+void drain(size_t maxBytes) {
+    size_t emitted = 0;
+
+    while (emitted < maxBytes) {
+        char line[LOG_MAX_LINE + 1];
+        size_t lineLen = 0;
+
+        taskENTER_CRITICAL(&g_ringMux);
+        if (g_used > 0) {
+            lineLen = static_cast<unsigned char>(g_ring[g_head]);
+            g_head = (g_head + 1) % LOG_RING_SIZE;
+            for (size_t i = 0; i < lineLen; i++) {
+                line[i] = g_ring[g_head];
+                g_head = (g_head + 1) % LOG_RING_SIZE;
+            }
+            g_used -= (lineLen + 1);
+        }
+        taskEXIT_CRITICAL(&g_ringMux);
+
+        if (lineLen == 0) {
+            break; // Ring empty
+        }
+
+        // Serial I/O happens outside the critical section
+        Serial.write(reinterpret_cast<const uint8_t*>(line), lineLen);
+        emitted += lineLen;
+    }
+}
+
+uint32_t droppedLines() {
+    return g_dropped;
+}
+
+} // namespace Log
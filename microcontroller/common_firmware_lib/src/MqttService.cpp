@@ -1,6 +1,9 @@
 #include "services/MqttService.h"
 #include <Arduino.h> // For Serial, millis(), etc.
 #include "actuators/ActuatorControlPoint.h"
+#include "utils/ThreadSafeCommandQueue.h"
+#include "services/OtaUpdateService.h"
+#include "utils/Log.h"
 
 // Initialize static member pointer. This is crucial for the static callback.
 MqttService* MqttService::_instance = nullptr;
@@ -14,30 +17,35 @@ MqttService::MqttService(const char* client_id,
       _port(port),
       _user(user),
       _password(password),
-      _topicToActuatorMap(nullptr),
-      _pendingCommands(nullptr),
-      _processQueue(nullptr),
-      _processSet(nullptr) {
+      _dispatchEntries(nullptr),
+      _dispatchCount(0),
+      _commandQueue(nullptr),
+      _otaService(nullptr) {
+    _clientMutex = xSemaphoreCreateRecursiveMutex();
     _instance = this;
 }
 
 void MqttService::begin() {
     mqttClient.setServer(_server.c_str(), _port);
     mqttClient.setCallback(MqttService::staticMqttCallback);
+
+    // Explicit client buffer ownership: sized here, once, so payload
+    // formatters have a known bound instead of silently colliding with
+    // PubSubClient's 256-byte default (which drops oversized publishes).
+    if (!mqttClient.setBufferSize(MQTT_CLIENT_BUFFER_SIZE)) {
+        LOG_ERROR("MQTT client buffer allocation failed (%d bytes)", MQTT_CLIENT_BUFFER_SIZE);
+    }
 }
 
 void MqttService::setCommandManagement(
-    std::map<String, ActuatorControlPoint*>* topicToActuatorMap,
-    std::map<ActuatorControlPoint*, String>* pendingCommands,
-    std::queue<ActuatorControlPoint*>* processQueue,
-    std::set<ActuatorControlPoint*>* processSet) {
-    
-    _topicToActuatorMap = topicToActuatorMap;
-    _pendingCommands = pendingCommands;
-    _processQueue = processQueue;
-    _processSet = processSet;
-    
-    Serial.println("Command management structures set for MqttService");
+    const TopicDispatchEntry* dispatchEntries, size_t dispatchCount,
+    ThreadSafeCommandQueue* commandQueue) {
+
+    _dispatchEntries = dispatchEntries;
+    _dispatchCount = dispatchCount;
+    _commandQueue = commandQueue;
+
+    LOG_INFO("Command management structures set for MqttService");
 }
 
 bool MqttService::loop() {
@@ -48,26 +56,39 @@ bool MqttService::loop() {
     //         connectBroker(); // Attempt to reconnect (this was reconnect() before)
     //     }
     // }
-    return mqttClient.loop(); // Essential for PubSubClient to process messages and keepalive
+    xSemaphoreTakeRecursive(_clientMutex, portMAX_DELAY);
+    bool result = mqttClient.loop(); // Essential for PubSubClient to process messages and keepalive
+    xSemaphoreGiveRecursive(_clientMutex);
+    return result;
 }
 
 bool MqttService::isConnected() {
-    return mqttClient.connected();
+    xSemaphoreTakeRecursive(_clientMutex, portMAX_DELAY);
+    bool result = mqttClient.connected();
+    xSemaphoreGiveRecursive(_clientMutex);
+    return result;
+}
+
+void MqttService::resetConnection() {
+    LOG_WARN("Warm recovery: tearing down MQTT session and socket");
+    xSemaphoreTakeRecursive(_clientMutex, portMAX_DELAY);
+    mqttClient.disconnect();  // Clean MQTT DISCONNECT if the session is up
+    wifiClient.stop();        // Drop the TCP socket regardless
+    xSemaphoreGiveRecursive(_clientMutex);
 }
 
 // Renamed from reconnect() and made public. Returns bool for success.
 bool MqttService::connectBroker() {
-    if (mqttClient.connected()) {
+    if (isConnected()) {
         return true; // Already connected
     }
 
-    Serial.print("Attempting MQTT connection to ");
-    Serial.print(_server);
-    Serial.print(":");
-    Serial.print(_port);
-    Serial.print(" as ");
-    Serial.print(_clientId);
-    Serial.print("...");
+    // Hold the client mutex for the whole connection attempt so NetworkTask's
+    // loop() doesn't interleave with the handshake
+    xSemaphoreTakeRecursive(_clientMutex, portMAX_DELAY);
+
+    LOG_INFO("Attempting MQTT connection to %s:%d as %s",
+             _server.c_str(), _port, _clientId.c_str());
 
     bool result;
     if (_user.length() > 0) {
@@ -77,32 +98,30 @@ bool MqttService::connectBroker() {
     }
 
     if (result) {
-        Serial.println(" connected.");
+        LOG_INFO("MQTT connected.");
         // TODO: Resubscribe to topics here if needed after a reconnect
         // (Will be relevant for P1.C2.4 and beyond)
     } else {
-        Serial.print(" failed, rc=");
-        Serial.print(mqttClient.state());
-        Serial.println("."); // Removed "Trying again in 5 seconds."
+        LOG_WARN("MQTT connect failed, rc=%d", mqttClient.state());
         // Note: The actual retry is governed by the FSM calling this method again.
     }
+    xSemaphoreGiveRecursive(_clientMutex);
     return result; // Return the connection attempt status
 }
 
 bool MqttService::subscribe(const char* topic) {
     if (!isConnected()) {
-        Serial.print("MQTT not connected. Cannot subscribe to: ");
-        Serial.println(topic);
+        LOG_WARN("MQTT not connected. Cannot subscribe to: %s", topic);
         return false;
     }
-    
+
+    xSemaphoreTakeRecursive(_clientMutex, portMAX_DELAY);
     bool result = mqttClient.subscribe(topic);
+    xSemaphoreGiveRecursive(_clientMutex);
     if (result) {
-        Serial.print("Successfully subscribed to: ");
-        Serial.println(topic);
+        LOG_INFO("Successfully subscribed to: %s", topic);
     } else {
-        Serial.print("Failed to subscribe to: ");
-        Serial.println(topic);
+        LOG_WARN("Failed to subscribe to: %s", topic);
     }
     return result;
 }
@@ -114,103 +133,142 @@ void MqttService::staticMqttCallback(char* topic, byte* payload, unsigned int le
     }
 }
 
-// Instance-specific callback (currently lean)
+// Bounded substring search over a raw (not NUL-terminated) buffer
+static const char* findToken(const char* haystack, unsigned int haystackLen,
+                             const char* needle, unsigned int needleLen) {
+    if (needleLen == 0 || needleLen > haystackLen) {
+        return nullptr;
+    }
+    const char* end = haystack + (haystackLen - needleLen);
+    for (const char* p = haystack; p <= end; p++) {
+        if (memcmp(p, needle, needleLen) == 0) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+// Instance-specific callback. Zero-copy: parses the ADR-10 value field in
+// place on PubSubClient's buffer - no stack copy, no String construction,
+// single pass. This is the humidifier's control loop on controller2, so
+// callback-to-queue cost matters.
 void MqttService::instanceMqttCallback(char* topic, byte* payload, unsigned int length) {
-    Serial.print("Message arrived [");
-    Serial.print(topic);
-    Serial.print("] ");
-    
-    // Create null-terminated string from payload
-    char msg[length + 1];
-    memcpy(msg, payload, length);
-    msg[length] = '\0'; // Null-terminate the string
-    Serial.println(msg);
+    // OTA messages (including binary chunks) get first crack at the payload,
+    // before any logging or command parsing touches it
+    if (_otaService != nullptr && _otaService->handleMessage(topic, payload, length)) {
+        return;
+    }
+
+    LOG_DEBUG("MQTT rx [%s] %.*s", topic, static_cast<int>(length),
+              reinterpret_cast<const char*>(payload));
 
     // Check if command management is set up
-    if (!_topicToActuatorMap || !_pendingCommands || !_processQueue || !_processSet) {
-        Serial.println("Command management not initialized - ignoring message");
+    if (!_dispatchEntries || !_commandQueue) {
+        LOG_WARN("Command management not initialized - ignoring message");
+        return;
+    }
+
+    // Look up actuator for this topic: FNV-1a hash + uint32 compares + one
+    // confirming strcmp against the precomputed dispatch table
+    ActuatorControlPoint* targetActuator = TopicDispatch::lookup(_dispatchEntries, _dispatchCount, topic);
+    if (targetActuator == nullptr) {
+        LOG_WARN("No actuator found for topic: %s", topic);
         return;
     }
 
-    String topicStr = String(topic);
-    String payloadStr = String(msg);
-    
-    // Look up actuator for this topic
-    auto it = _topicToActuatorMap->find(topicStr);
-    if (it == _topicToActuatorMap->end()) {
-        Serial.print("No actuator found for topic: ");
-        Serial.println(topicStr);
+    LOG_DEBUG("Found actuator: %s", targetActuator->getPointName());
+
+    // Parse ADR-10 JSON payload in place
+    const char* buf = reinterpret_cast<const char*>(payload);
+    if (length < 2 || buf[0] != '{' || buf[length - 1] != '}') {
+        LOG_WARN("Invalid payload - expected ADR-10 JSON format");
         return;
     }
-    
-    ActuatorControlPoint* targetActuator = it->second;
-    Serial.print("Found actuator: ");
-    Serial.println(targetActuator->getPointName());
-    
-    // Parse ADR-10 JSON payload
-    if (!payloadStr.startsWith("{") || !payloadStr.endsWith("}")) {
-        Serial.println("Invalid payload - expected ADR-10 JSON format");
+
+    // Extract value field from JSON (length-delimited view, no copy)
+    static const char VALUE_KEY[] = "\"value\":\"";
+    const unsigned int VALUE_KEY_LEN = sizeof(VALUE_KEY) - 1;
+    const char* keyPos = findToken(buf, length, VALUE_KEY, VALUE_KEY_LEN);
+    if (keyPos == nullptr) {
+        LOG_WARN("Invalid payload - missing 'value' field");
         return;
     }
-    
-    // Extract value field from JSON
-    int valueStart = payloadStr.indexOf("\"value\":\"");
-    if (valueStart == -1) {
-        Serial.println("Invalid payload - missing 'value' field");
+
+    const char* valueStart = keyPos + VALUE_KEY_LEN;
+    unsigned int remaining = length - static_cast<unsigned int>(valueStart - buf);
+    const char* valueEnd = static_cast<const char*>(memchr(valueStart, '"', remaining));
+    if (valueEnd == nullptr) {
+        LOG_WARN("Invalid payload - malformed 'value' field");
         return;
     }
-    
-    valueStart += 9; // Move past "value":"
-    int valueEnd = payloadStr.indexOf("\"", valueStart);
-    if (valueEnd == -1) {
-        Serial.println("Invalid payload - malformed 'value' field");
+    unsigned int valueLen = static_cast<unsigned int>(valueEnd - valueStart);
+
+    // Validate command: length + memcmp against the only accepted payloads
+    bool isOn = (valueLen == 2 && memcmp(valueStart, "on", 2) == 0);
+    bool isOff = (valueLen == 3 && memcmp(valueStart, "off", 3) == 0);
+    if (!isOn && !isOff) {
+        LOG_WARN("Invalid command value: %.*s",
+                 static_cast<int>(valueLen < 16 ? valueLen : 16), valueStart); // Bounded echo
         return;
     }
-    
-    String commandValue = payloadStr.substring(valueStart, valueEnd);
-    Serial.print("Parsed command: ");
-    Serial.println(commandValue);
-    
-    // Validate command
-    if (commandValue != "on" && commandValue != "off") {
-        Serial.print("Invalid command value: ");
-        Serial.println(commandValue);
+
+    // "on"/"off" fit in Arduino String's small-string buffer, so queueing
+    // the canonical literal allocates nothing
+    String commandValue = isOn ? "on" : "off";
+    LOG_DEBUG("Parsed command: %s", commandValue.c_str());
+
+    // Stamp receipt for end-to-end latency instrumentation (both paths)
+    targetActuator->markCommandReceived();
+
+    // Fast path for designated critical actuators: the validated command
+    // hits digitalWrite right here instead of waiting out the FSM hops -
+    // receipt-to-actuation in microseconds. The FSM only handles the
+    // readback publish afterward (digitalWrite is cross-core safe).
+    if (targetActuator->isCriticalFastPath()) {
+        if (targetActuator->executeDeviceCommand(commandValue)) {
+            targetActuator->setLastSuccessfulPayload(commandValue);
+            targetActuator->recordCommandExecuted();
+            targetActuator->setFastPathReadbackPending(true);
+            LOG_DEBUG("Fast path executed '%s' for: %s", commandValue.c_str(), targetActuator->getPointName());
+        } else {
+            LOG_WARN("Fast path execution failed for: %s", targetActuator->getPointName());
+        }
         return;
     }
-    
-    // Update command management structures (latest wins logic)
-    (*_pendingCommands)[targetActuator] = commandValue;
-    
-    // Add to processing queue if not already queued
-    if (_processSet->find(targetActuator) == _processSet->end()) {
-        _processQueue->push(targetActuator);
-        _processSet->insert(targetActuator);
-        Serial.print("Queued command '");
-        Serial.print(commandValue);
-        Serial.print("' for: ");
-        Serial.println(targetActuator->getPointName());
+
+    // Queue via the thread-safe command queue (latest wins logic)
+    if (_commandQueue->queueCommand(targetActuator, commandValue)) {
+        LOG_DEBUG("Queued command '%s' for: %s", commandValue.c_str(), targetActuator->getPointName());
     } else {
-        Serial.print("Updated existing command to '");
-        Serial.print(commandValue);
-        Serial.print("' for: ");
-        Serial.println(targetActuator->getPointName());
+        LOG_DEBUG("Updated existing command to '%s' for: %s", commandValue.c_str(), targetActuator->getPointName());
     }
 }
 
+void MqttService::setOtaService(OtaUpdateService* otaService) {
+    _otaService = otaService;
+}
+
 // --- publishJson Implementations ---
 
-bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, const char* value) {
+// Shared error-check + mutex-guarded publish for all publishJson overloads
+bool MqttService::publishBuiltPayload(const char* topic, const String& payload) {
     if (!isConnected()) {
-        Serial.println("MQTT not connected. Cannot publish.");
+        LOG_WARN("MQTT not connected. Cannot publish.");
         return false;
     }
-    String payload = JsonBuilder::buildPayload(timestamp_utc, uuid, value);
     if (payload.indexOf("error") != -1 && payload.startsWith("{")) { // Basic check for error JSON
-        Serial.print("JsonBuilder error: "); Serial.println(payload);
+        LOG_ERROR("JsonBuilder error: %s", payload.c_str());
         return false;
     }
-    //Serial.print("Publishing to "); Serial.print(topic); Serial.print(": "); Serial.println(payload); 
-    return mqttClient.publish(topic, payload.c_str());
+    //Serial.print("Publishing to "); Serial.print(topic); Serial.print(": "); Serial.println(payload);
+    xSemaphoreTakeRecursive(_clientMutex, portMAX_DELAY);
+    bool result = mqttClient.publish(topic, payload.c_str());
+    xSemaphoreGiveRecursive(_clientMutex);
+    return result;
+}
+
+bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, const char* value) {
+    return publishBuiltPayload(topic, JsonBuilder::buildPayload(timestamp_utc, uuid, value));
 }
 
 bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, String value) {
@@ -218,57 +276,114 @@ bool MqttService::publishJson(const char* topic, const String& timestamp_utc, co
 }
 
 bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, int value) {
-    // Use JsonBuilder directly instead of converting to string first
+    return publishBuiltPayload(topic, JsonBuilder::buildPayload(timestamp_utc, uuid, value));
+}
+
+bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, float value, int decimalPlaces) {
+    return publishBuiltPayload(topic, JsonBuilder::buildPayload(timestamp_utc, uuid, value, decimalPlaces));
+}
+
+bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, double value, int decimalPlaces) {
+    return publishBuiltPayload(topic, JsonBuilder::buildPayload(timestamp_utc, uuid, value, decimalPlaces));
+}
+
+bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, bool value) {
+    return publishBuiltPayload(topic, JsonBuilder::buildPayload(timestamp_utc, uuid, value));
+}
+
+// --- Zero-allocation publishJson overloads ---
+
+bool MqttService::publishJson(const char* topic, const char* timestamp_utc, const char* uuid, const char* value) {
     if (!isConnected()) {
-        Serial.println("MQTT not connected. Cannot publish.");
+        LOG_WARN("MQTT not connected. Cannot publish.");
         return false;
     }
-    String payload = JsonBuilder::buildPayload(timestamp_utc, uuid, value);
-    if (payload.indexOf("error") != -1 && payload.startsWith("{")) { // Basic check for error JSON
-        Serial.print("JsonBuilder error: "); Serial.println(payload);
+
+    char payload[JsonBuilder::MAX_PAYLOAD_SIZE];
+    size_t length = JsonBuilder::buildPayloadInto(payload, sizeof(payload), timestamp_utc, uuid, value);
+    if (length == 0) {
+        LOG_ERROR("JsonBuilder error: could not build payload for topic %s", topic);
         return false;
     }
-    return mqttClient.publish(topic, payload.c_str());
+
+    xSemaphoreTakeRecursive(_clientMutex, portMAX_DELAY);
+    bool result = mqttClient.publish(topic, payload);
+    xSemaphoreGiveRecursive(_clientMutex);
+    return result;
 }
 
-bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, float value, int decimalPlaces) {
-    // Use JsonBuilder directly instead of converting to string first
-    if (!isConnected()) {
-        Serial.println("MQTT not connected. Cannot publish.");
-        return false;
-    }
-    String payload = JsonBuilder::buildPayload(timestamp_utc, uuid, value, decimalPlaces);
-    if (payload.indexOf("error") != -1 && payload.startsWith("{")) { // Basic check for error JSON
-        Serial.print("JsonBuilder error: "); Serial.println(payload);
+bool MqttService::publishJson(const char* topic, const char* timestamp_utc, const char* uuid, int value) {
+    char valueBuffer[12]; // Enough for a 32-bit integer string + null terminator
+    sprintf(valueBuffer, "%d", value);
+    return publishJson(topic, timestamp_utc, uuid, static_cast<const char*>(valueBuffer));
+}
+
+bool MqttService::publishJson(const char* topic, const char* timestamp_utc, const char* uuid, float value, int decimalPlaces) {
+    char valueBuffer[32]; // Generous buffer for float string
+    dtostrf(value, 0, decimalPlaces, valueBuffer);
+    return publishJson(topic, timestamp_utc, uuid, static_cast<const char*>(valueBuffer));
+}
+
+// --- Raw publish path ---
+
+bool MqttService::publishRaw(const char* topic, const char* payload) {
+    // Streamed: telemetry summaries run right at the packet-buffer bound,
+    // so bypass it and copy the bytes once
+    size_t length = strlen(payload);
+    if (!beginStreamPublish(topic, length)) {
         return false;
     }
-    return mqttClient.publish(topic, payload.c_str());
+    size_t written = streamWrite(reinterpret_cast<const uint8_t*>(payload), length);
+    bool result = endStreamPublish();
+    return result && written == length;
 }
 
-bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, double value, int decimalPlaces) {
-    // Use JsonBuilder directly instead of converting to string first
+// --- Streaming publish path ---
+
+bool MqttService::beginStreamPublish(const char* topic, size_t payloadLength) {
     if (!isConnected()) {
-        Serial.println("MQTT not connected. Cannot publish.");
+        LOG_WARN("MQTT not connected. Cannot publish.");
         return false;
     }
-    String payload = JsonBuilder::buildPayload(timestamp_utc, uuid, value, decimalPlaces);
-    if (payload.indexOf("error") != -1 && payload.startsWith("{")) { // Basic check for error JSON
-        Serial.print("JsonBuilder error: "); Serial.println(payload);
+
+    xSemaphoreTakeRecursive(_clientMutex, portMAX_DELAY);
+    if (!mqttClient.beginPublish(topic, payloadLength, false)) {
+        xSemaphoreGiveRecursive(_clientMutex);
+        LOG_WARN("MQTT beginPublish failed for topic %s", topic);
         return false;
     }
-    return mqttClient.publish(topic, payload.c_str());
+    // NOTE: mutex intentionally held until endStreamPublish() so no other
+    // client traffic interleaves with the in-flight packet
+    return true;
 }
 
-bool MqttService::publishJson(const char* topic, const String& timestamp_utc, const String& uuid, bool value) {
-    // Use JsonBuilder directly instead of converting to string first
-    if (!isConnected()) {
-        Serial.println("MQTT not connected. Cannot publish.");
+size_t MqttService::streamWrite(const uint8_t* data, size_t length) {
+    return mqttClient.write(data, length);
+}
+
+bool MqttService::endStreamPublish() {
+    bool result = (mqttClient.endPublish() != 0);
+    xSemaphoreGiveRecursive(_clientMutex);
+    return result;
+}
+
+// --- Batched publish path ---
+
+bool MqttService::publishJsonBatch(const char* topic, const char* timestamp_utc,
+                                   const BatchReadingEntry* entries, size_t entryCount) {
+    char payload[JsonBuilder::MAX_BATCH_PAYLOAD_SIZE];
+    size_t length = JsonBuilder::buildBatchPayloadInto(payload, sizeof(payload), timestamp_utc, entries, entryCount);
+    if (length == 0) {
+        LOG_ERROR("JsonBuilder error: could not build batch payload for topic %s", topic);
         return false;
     }
-    String payload = JsonBuilder::buildPayload(timestamp_utc, uuid, value);
-    if (payload.indexOf("error") != -1 && payload.startsWith("{")) { // Basic check for error JSON
-        Serial.print("JsonBuilder error: "); Serial.println(payload);
+
+    // Stream into the socket: batches aren't bounded by the packet buffer
+    // and the bytes are copied once instead of twice
+    if (!beginStreamPublish(topic, length)) {
         return false;
     }
-    return mqttClient.publish(topic, payload.c_str());
+    size_t written = streamWrite(reinterpret_cast<const uint8_t*>(payload), length);
+    bool result = endStreamPublish();
+    return result && written == length;
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "services/NetworkTask.h"
+#include "services/MqttService.h"
+#include "services/NtpService.h"
+
+NetworkTask::NetworkTask()
+    : _mqttService(nullptr),
+      _ntpService(nullptr),
+      _taskHandle(nullptr) {
+}
+
+bool NetworkTask::begin(MqttService& mqtt, NtpService& ntp) {
+    if (_taskHandle != nullptr) {
+        Serial.println("NetworkTask: already running");
+        return true;
+    }
+
+    _mqttService = &mqtt;
+    _ntpService = &ntp;
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        NetworkTask::taskEntry,
+        "networkTask",
+        NETWORK_TASK_STACK_SIZE,
+        this,
+        NETWORK_TASK_PRIORITY,
+        &_taskHandle,
+        NETWORK_TASK_CORE
+    );
+
+    if (result != pdPASS) {
+        Serial.println("NetworkTask: FAILED to create network task");
+        _taskHandle = nullptr;
+        return false;
+    }
+
+    Serial.println("NetworkTask: network servicing pinned to core 0");
+    return true;
+}
+
+bool NetworkTask::isRunning() const {
+    return _taskHandle != nullptr;
+}
+
+void NetworkTask::taskEntry(void* instance) {
+    static_cast<NetworkTask*>(instance)->run();
+}
+
+void NetworkTask::run() {
+    unsigned long lastNtpUpdate = millis();
+
+    for (;;) {
+        // Service MQTT keepalive and inbound messages. MqttService's internal
+        // mutex keeps this safe against FSM publishes from core 1.
+        _mqttService->loop();
+
+        // Periodically check NTP sync status (cheap - just reads system time)
+        unsigned long now = millis();
+        if (now - lastNtpUpdate >= NTP_TASK_UPDATE_INTERVAL_MS) {
+            _ntpService->update();
+            lastNtpUpdate = now;
+        }
+
+        vTaskDelay(NETWORK_TASK_INTERVAL_TICKS);
+    }
+}
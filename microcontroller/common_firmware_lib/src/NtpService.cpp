@@ -1,6 +1,7 @@
 #include "services/NtpService.h"
 #include <time.h> // Required for time_t, struct tm, gmtime, sprintf
 #include <sys/time.h>   // Required for gettimeofday, struct timeval
+#include <esp_sntp.h>   // For sntp_get_sync_status (carried-time re-truing)
 
 // Default NTP server if not configured otherwise
 const char* NTP_SERVER = "pool.ntp.org"; 
@@ -15,9 +16,29 @@ const unsigned int NTP_UPDATE_INTERVAL_MS = 60000;
 // For simplicity, any time significantly past epoch (e.g. > 1000000000 which is in 2001) indicates sync.
 const unsigned long MIN_VALID_EPOCH_TIME_SEC = 1577836800UL; // Approx Jan 1, 2020 UTC
 
-NtpService::NtpService() 
+// Time carryover block in RTC-noinit memory: survives ESP.restart() (and
+// panics/watchdog resets), lost only on power-off. Checksummed so garbage
+// after a cold boot is never mistaken for carried time.
+namespace {
+    struct TimeCarryover {
+        uint64_t epochAtRestart;  // Seconds since epoch when prepareForRestart() ran
+        uint32_t checksum;
+    };
+
+    RTC_NOINIT_ATTR TimeCarryover g_timeCarryover;
+
+    uint32_t carryoverChecksum(const TimeCarryover& carryover) {
+        return 0x544D4330u ^ static_cast<uint32_t>(carryover.epochAtRestart) ^
+               static_cast<uint32_t>(carryover.epochAtRestart >> 32);
+    }
+}
+
+NtpService::NtpService()
     // : timeClient(ntpUDP, NTP_SERVER, GMT_OFFSET_SEC, NTP_UPDATE_INTERVAL_MS), // Removed NTPClient initialization
-      : timeSuccessfullySet(false) {
+      : timeSuccessfullySet(false),
+        timeCarriedFromRestart(false),
+        _cachedSecond(0) {
+    _cachedTimestamp[0] = '\0';
 }
 
 void NtpService::begin() {
@@ -27,9 +48,42 @@ void NtpService::begin() {
     // NTP_SERVER is "pool.ntp.org".
     configTime(GMT_OFFSET_SEC, 0, NTP_SERVER); 
     
+    // Warm-boot carryover: if the previous run stashed its epoch before
+    // restarting, restore it (one-shot) so timestamps are valid immediately
+    // instead of waiting several seconds for the first NTP response.
+    if (g_timeCarryover.checksum == carryoverChecksum(g_timeCarryover) &&
+        g_timeCarryover.epochAtRestart > MIN_VALID_EPOCH_TIME_SEC) {
+        struct timeval tv;
+        tv.tv_sec = static_cast<time_t>(g_timeCarryover.epochAtRestart);
+        tv.tv_usec = 0;
+        settimeofday(&tv, NULL);
+
+        timeSuccessfullySet = true;
+        timeCarriedFromRestart = true;
+        Serial.print("NtpService: carried time restored across restart, epoch ");
+        Serial.println(static_cast<unsigned long>(tv.tv_sec));
+    }
+    g_timeCarryover.checksum = 0; // One-shot: never reuse a stale carryover
+
     // timeClient.begin(); // Removed: No longer using NTPClient directly
 }
 
+void NtpService::prepareForRestart() {
+    if (!timeSuccessfullySet) {
+        g_timeCarryover.checksum = 0; // Nothing valid to carry
+        return;
+    }
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    g_timeCarryover.epochAtRestart = static_cast<uint64_t>(tv.tv_sec);
+    g_timeCarryover.checksum = carryoverChecksum(g_timeCarryover);
+}
+
+bool NtpService::isTimeCarried() const {
+    return timeCarriedFromRestart;
+}
+
 bool NtpService::update() {
     // This method now checks if the system time (presumably set by system NTP via configTime)
     // is valid. It no longer actively polls with NTPClient.
@@ -42,6 +96,11 @@ bool NtpService::update() {
             // Optionally, log the first successful sync
             // Serial.println("System time appears to be synchronized (post-epoch check).");
         }
+        // Once a real SNTP response lands, carried precision is upgraded
+        if (timeCarriedFromRestart && sntp_get_sync_status() == SNTP_SYNC_STATUS_COMPLETED) {
+            timeCarriedFromRestart = false;
+            Serial.println("NtpService: carried time re-trued by NTP");
+        }
     } else {
         // If time is not yet valid, ensure our flag reflects that.
         // This could happen if NTP sync is lost or not yet achieved.
@@ -60,36 +119,58 @@ unsigned long NtpService::getEpochTime() const {
     return tv.tv_sec; // Return system epoch time
 }
 
+void NtpService::refreshCachedTimestamp() const {
+    struct timeval tv;
+    gettimeofday(&tv, NULL); // Get current time with microsecond precision
+
+    long milliseconds = tv.tv_usec / 1000;
+
+    if (tv.tv_sec != _cachedSecond || _cachedTimestamp[0] == '\0') {
+        // Second rolled over (or first call) - full reformat
+        struct tm *ptm = gmtime(&tv.tv_sec); // Convert seconds to UTC time structure
+
+        // Format to YYYY-MM-DDTHH:MM:SS.sssZ
+        // Note: tm_year is years since 1900, tm_mon is 0-11
+        sprintf(_cachedTimestamp, "%04d-%02d-%02dT%02d:%02d:%02d.%03ldZ",
+                ptm->tm_year + 1900, ptm->tm_mon + 1, ptm->tm_mday,
+                ptm->tm_hour, ptm->tm_min, ptm->tm_sec,
+                milliseconds);
+        _cachedSecond = tv.tv_sec;
+    } else {
+        // Same second - the 20-char date/time prefix is unchanged; patch
+        // only the millisecond digits (positions 20..22 of "....SS.sssZ")
+        _cachedTimestamp[20] = '0' + (milliseconds / 100);
+        _cachedTimestamp[21] = '0' + ((milliseconds / 10) % 10);
+        _cachedTimestamp[22] = '0' + (milliseconds % 10);
+    }
+}
+
 String NtpService::getFormattedISO8601Time() const {
     if (!timeSuccessfullySet) {
-        return String("Time not set"); 
+        return String("Time not set");
     }
 
-    struct timeval tv;
-    gettimeofday(&tv, NULL); // Get current time with microsecond precision
+    refreshCachedTimestamp();
+    return String(_cachedTimestamp);
+}
 
-    // --- TEMPORARY DIAGNOSTIC ---
-    // Serial.print("[getFormattedISO8601Time] tv.tv_sec before formatting: ");
-    // Serial.println(tv.tv_sec);
-    // --- END TEMPORARY DIAGNOSTIC ---
+const char* NtpService::getIso8601Cstr() const {
+    if (!timeSuccessfullySet) {
+        return "Time not set";
+    }
 
-    // tv.tv_sec contains seconds since epoch (like time_t)
-    // tv.tv_usec contains microseconds
+    refreshCachedTimestamp();
+    return _cachedTimestamp;
+}
 
-    struct tm *ptm = gmtime(&tv.tv_sec); // Convert seconds to UTC time structure
+bool NtpService::fillFormattedISO8601Time(char* buffer, size_t bufferSize) const {
+    if (!timeSuccessfullySet || buffer == nullptr || bufferSize < ISO8601_BUFFER_SIZE) {
+        return false;
+    }
 
-    // Buffer for "YYYY-MM-DDTHH:MM:SS.sssZ" + null terminator (24 chars + 1 = 25)
-    char buffer[25]; 
-    
-    // Format to YYYY-MM-DDTHH:MM:SS.sssZ
-    // Note: tm_year is years since 1900, tm_mon is 0-11
-    // tv.tv_usec / 1000 gives milliseconds
-    sprintf(buffer, "%04d-%02d-%02dT%02d:%02d:%02d.%03ldZ",
-            ptm->tm_year + 1900, ptm->tm_mon + 1, ptm->tm_mday,
-            ptm->tm_hour, ptm->tm_min, ptm->tm_sec, 
-            tv.tv_usec / 1000); // Add milliseconds
-            
-    return String(buffer);
+    refreshCachedTimestamp();
+    memcpy(buffer, _cachedTimestamp, ISO8601_BUFFER_SIZE);
+    return true;
 }
 
 bool NtpService::isTimeSet() const {
@@ -0,0 +1,371 @@
+#include "services/OtaUpdateService.h"
+#include "services/MqttService.h"
+
+// Message type tags (first byte of every OTA message - see header)
+static const uint8_t OTA_MSG_CONTROL = 'C';
+static const uint8_t OTA_MSG_DATA = 'D';
+
+// Delta record opcodes (see header for the stream format)
+static const uint8_t DELTA_OP_COPY = 0x00;
+static const uint8_t DELTA_OP_ADD = 0x01;
+
+// COPY records are applied through a bounded stack buffer
+static const size_t DELTA_COPY_BUFFER_SIZE = 256;
+
+OtaUpdateService::OtaUpdateService()
+    : _state(OTA_IDLE),
+      _controlTopic(nullptr),
+      _otaHandle(0),
+      _updatePartition(nullptr),
+      _runningPartition(nullptr),
+      _expectedImageSize(0),
+      _writtenBytes(0),
+      _nextChunkSeq(0),
+      _deltaMode(false),
+      _recordHeaderFill(0),
+      _recordOp(0),
+      _recordRemaining(0),
+      _recordSrcOffset(0),
+      _recordActive(false) {
+}
+
+bool OtaUpdateService::subscribe(MqttService& mqtt, const char* controlTopic) {
+    _controlTopic = controlTopic;
+    return mqtt.subscribe(controlTopic);
+}
+
+bool OtaUpdateService::handleMessage(const char* topic, const uint8_t* payload, unsigned int length) {
+    if (_controlTopic == nullptr || strcmp(topic, _controlTopic) != 0) {
+        return false; // Not ours
+    }
+
+    // Out-of-band type tag: chunk content can never be mistaken for a
+    // control message (a payload-sniffing discriminator would misroute any
+    // chunk whose sequence number's low byte happened to be '{')
+    if (length < 1) {
+        Serial.println("OtaUpdateService: empty message - ignoring");
+        return true;
+    }
+
+    if (payload[0] == OTA_MSG_CONTROL) {
+        handleControlMessage(payload + 1, length - 1);
+    } else if (payload[0] == OTA_MSG_DATA) {
+        handleDataChunk(payload + 1, length - 1);
+    } else {
+        Serial.println("OtaUpdateService: unknown message type tag - ignoring");
+    }
+    return true; // Consumed either way
+}
+
+bool OtaUpdateService::isReadyToReboot() const {
+    return _state == OTA_READY;
+}
+
+bool OtaUpdateService::isTransferActive() const {
+    return _state == OTA_RECEIVING;
+}
+
+void OtaUpdateService::markRunningImageValid() {
+    // No-op unless the bootloader has the image in pending-verify state
+    // (requires CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE - see the header)
+    esp_ota_mark_app_valid_cancel_rollback();
+}
+
+// Minimal field scan over the small control JSON - same in-place style as
+// the command parsing in MqttService (no ArduinoJson document needed)
+static bool findJsonUint(const char* buf, unsigned int length, const char* key, uint32_t& out) {
+    char pattern[32];
+    int patternLen = snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    if (patternLen <= 0 || static_cast<size_t>(patternLen) >= sizeof(pattern)) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i + patternLen < length; i++) {
+        if (memcmp(buf + i, pattern, patternLen) == 0) {
+            uint32_t value = 0;
+            unsigned int p = i + patternLen;
+            bool anyDigit = false;
+            while (p < length && buf[p] >= '0' && buf[p] <= '9') {
+                value = value * 10 + (buf[p] - '0');
+                anyDigit = true;
+                p++;
+            }
+            if (!anyDigit) {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool hasJsonAction(const char* buf, unsigned int length, const char* action) {
+    char pattern[48];
+    int patternLen = snprintf(pattern, sizeof(pattern), "\"action\":\"%s\"", action);
+    if (patternLen <= 0 || static_cast<size_t>(patternLen) >= sizeof(pattern)) {
+        return false;
+    }
+    for (unsigned int i = 0; i + patternLen <= length; i++) {
+        if (memcmp(buf + i, pattern, patternLen) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool OtaUpdateService::handleControlMessage(const uint8_t* payload, unsigned int length) {
+    const char* buf = reinterpret_cast<const char*>(payload);
+
+    if (hasJsonAction(buf, length, "begin")) {
+        uint32_t imageSize = 0;
+        if (!findJsonUint(buf, length, "size", imageSize) || imageSize == 0) {
+            Serial.println("OtaUpdateService: begin without valid size - ignoring");
+            return false;
+        }
+        uint32_t delta = 0;
+        findJsonUint(buf, length, "delta", delta); // Optional, defaults to full image
+        return beginTransfer(imageSize, delta != 0);
+    }
+
+    if (hasJsonAction(buf, length, "commit")) {
+        return commitTransfer();
+    }
+
+    if (hasJsonAction(buf, length, "abort")) {
+        abortTransfer("abort requested by sender");
+        return true;
+    }
+
+    Serial.println("OtaUpdateService: unknown control action - ignoring");
+    return false;
+}
+
+bool OtaUpdateService::beginTransfer(uint32_t imageSize, bool delta) {
+    if (_state == OTA_RECEIVING) {
+        abortTransfer("new begin while transfer active");
+    }
+
+    _runningPartition = esp_ota_get_running_partition();
+    _updatePartition = esp_ota_get_next_update_partition(NULL);
+    if (_updatePartition == nullptr || _runningPartition == nullptr) {
+        Serial.println("OtaUpdateService: no OTA partitions available");
+        return false;
+    }
+    if (imageSize > _updatePartition->size) {
+        Serial.println("OtaUpdateService: image larger than update partition");
+        return false;
+    }
+
+    esp_err_t err = esp_ota_begin(_updatePartition, imageSize, &_otaHandle);
+    if (err != ESP_OK) {
+        Serial.print("OtaUpdateService: esp_ota_begin failed: ");
+        Serial.println(err);
+        return false;
+    }
+
+    _state = OTA_RECEIVING;
+    _expectedImageSize = imageSize;
+    _writtenBytes = 0;
+    _nextChunkSeq = 0;
+    _deltaMode = delta;
+    _recordHeaderFill = 0;
+    _recordRemaining = 0;
+    _recordActive = false;
+
+    Serial.print("OtaUpdateService: transfer started (");
+    Serial.print(delta ? "delta" : "full");
+    Serial.print(", ");
+    Serial.print(imageSize);
+    Serial.println(" bytes final image)");
+    return true;
+}
+
+bool OtaUpdateService::handleDataChunk(const uint8_t* payload, unsigned int length) {
+    if (_state != OTA_RECEIVING) {
+        Serial.println("OtaUpdateService: data chunk with no active transfer - ignoring");
+        return false;
+    }
+    if (length < 5) { // 4-byte sequence header + at least one byte
+        abortTransfer("short data chunk");
+        return false;
+    }
+
+    uint32_t seq = static_cast<uint32_t>(payload[0]) |
+                   (static_cast<uint32_t>(payload[1]) << 8) |
+                   (static_cast<uint32_t>(payload[2]) << 16) |
+                   (static_cast<uint32_t>(payload[3]) << 24);
+    if (seq != _nextChunkSeq) {
+        abortTransfer("out-of-order chunk");
+        return false;
+    }
+    _nextChunkSeq++;
+
+    const uint8_t* data = payload + 4;
+    uint32_t dataLen = length - 4;
+
+    bool ok = _deltaMode ? applyDeltaBytes(data, dataLen) : writeImageBytes(data, dataLen);
+    if (!ok) {
+        abortTransfer("chunk apply failed");
+        return false;
+    }
+    return true;
+}
+
+bool OtaUpdateService::writeImageBytes(const uint8_t* data, uint32_t length) {
+    if (_writtenBytes + length > _expectedImageSize) {
+        Serial.println("OtaUpdateService: more bytes than announced image size");
+        return false;
+    }
+
+    esp_err_t err = esp_ota_write(_otaHandle, data, length);
+    if (err != ESP_OK) {
+        Serial.print("OtaUpdateService: esp_ota_write failed: ");
+        Serial.println(err);
+        return false;
+    }
+    _writtenBytes += length;
+    return true;
+}
+
+bool OtaUpdateService::applyCopyRecord(uint32_t srcOffset, uint32_t length) {
+    uint8_t buffer[DELTA_COPY_BUFFER_SIZE];
+
+    while (length > 0) {
+        uint32_t chunk = (length < DELTA_COPY_BUFFER_SIZE) ? length : DELTA_COPY_BUFFER_SIZE;
+        if (srcOffset + chunk > _runningPartition->size) {
+            Serial.println("OtaUpdateService: COPY record out of running image bounds");
+            return false;
+        }
+        esp_err_t err = esp_partition_read(_runningPartition, srcOffset, buffer, chunk);
+        if (err != ESP_OK) {
+            Serial.print("OtaUpdateService: running image read failed: ");
+            Serial.println(err);
+            return false;
+        }
+        if (!writeImageBytes(buffer, chunk)) {
+            return false;
+        }
+        srcOffset += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+bool OtaUpdateService::applyDeltaBytes(const uint8_t* data, uint32_t length) {
+    while (length > 0) {
+        if (!_recordActive) {
+            // Accumulate the record header (op byte + 4 or 8 bytes of fields)
+            _recordHeader[_recordHeaderFill++] = *data++;
+            length--;
+
+            uint8_t op = _recordHeader[0];
+            uint32_t headerNeeded = (op == DELTA_OP_COPY) ? 9 : 5;
+            if (op != DELTA_OP_COPY && op != DELTA_OP_ADD) {
+                Serial.println("OtaUpdateService: unknown delta opcode");
+                return false;
+            }
+            if (_recordHeaderFill < headerNeeded) {
+                continue;
+            }
+
+            // Header complete - decode it
+            _recordOp = op;
+            if (op == DELTA_OP_COPY) {
+                uint32_t srcOffset;
+                memcpy(&srcOffset, &_recordHeader[1], 4);
+                memcpy(&_recordRemaining, &_recordHeader[5], 4);
+                _recordSrcOffset = srcOffset;
+            } else {
+                memcpy(&_recordRemaining, &_recordHeader[1], 4);
+            }
+            _recordHeaderFill = 0;
+            _recordActive = true;
+
+            // COPY records have no body bytes in the stream - apply now.
+            // Zero-length records (either op) complete immediately, so a
+            // degenerate record can't wedge the byte loop.
+            if (_recordOp == DELTA_OP_COPY) {
+                if (!applyCopyRecord(_recordSrcOffset, _recordRemaining)) {
+                    return false;
+                }
+                _recordActive = false;
+            } else if (_recordRemaining == 0) {
+                _recordActive = false;
+            }
+            continue;
+        }
+
+        // ADD record body: literal bytes for the new image
+        uint32_t take = (length < _recordRemaining) ? length : _recordRemaining;
+        if (!writeImageBytes(data, take)) {
+            return false;
+        }
+        data += take;
+        length -= take;
+        _recordRemaining -= take;
+        if (_recordRemaining == 0) {
+            _recordActive = false;
+        }
+    }
+    return true;
+}
+
+bool OtaUpdateService::commitTransfer() {
+    if (_state != OTA_RECEIVING) {
+        Serial.println("OtaUpdateService: commit with no active transfer - ignoring");
+        return false;
+    }
+    if (_writtenBytes != _expectedImageSize) {
+        abortTransfer("commit before full image received");
+        return false;
+    }
+
+    // esp_ota_end validates the written image (magic byte, secure-boot
+    // signature when enabled) before we ever point the bootloader at it
+    esp_err_t err = esp_ota_end(_otaHandle);
+    _otaHandle = 0;
+    if (err != ESP_OK) {
+        Serial.print("OtaUpdateService: image validation failed: ");
+        Serial.println(err);
+        _state = OTA_IDLE;
+        return false;
+    }
+
+    // With CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE the staged image boots in
+    // pending-verify state and the bootloader reverts unless the new app
+    // confirms itself. Stock arduino-esp32 builds do NOT enable it - then
+    // esp_ota_end()'s structural validation is the only gate and a bad
+    // image boot-loops with no way back - so say so loudly at commit time
+    // instead of letting the fleet assume a safety net that isn't there.
+    if (!esp_ota_check_rollback_is_possible()) {
+        Serial.println("OtaUpdateService: WARNING - bootloader rollback not available "
+                       "(CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE off or no valid fallback "
+                       "image); a bad update will NOT auto-revert");
+    }
+
+    err = esp_ota_set_boot_partition(_updatePartition);
+    if (err != ESP_OK) {
+        Serial.print("OtaUpdateService: set boot partition failed: ");
+        Serial.println(err);
+        _state = OTA_IDLE;
+        return false;
+    }
+
+    _state = OTA_READY;
+    Serial.println("OtaUpdateService: update staged - FSM will restart into it");
+    return true;
+}
+
+void OtaUpdateService::abortTransfer(const char* reason) {
+    Serial.print("OtaUpdateService: transfer aborted - ");
+    Serial.println(reason);
+
+    if (_state == OTA_RECEIVING && _otaHandle != 0) {
+        esp_ota_abort(_otaHandle);
+        _otaHandle = 0;
+    }
+    _state = OTA_IDLE;
+    _recordActive = false;
+    _recordHeaderFill = 0;
+}
@@ -0,0 +1,140 @@
+#include "services/PerfTelemetryService.h"
+#include "services/MqttService.h"
+#include <esp_heap_caps.h>
+
+// Bin upper bounds: <0.5ms, <1ms, <2.5ms, <5ms, <10ms, <25ms, <100ms, >=100ms
+const uint32_t PerfTelemetryService::LOOP_HISTOGRAM_BOUNDS_US[PerfTelemetryService::LOOP_HISTOGRAM_BINS - 1] = {
+    500, 1000, 2500, 5000, 10000, 25000, 100000
+};
+
+PerfTelemetryService::PerfTelemetryService()
+    : _loopCount(0),
+      _loopMaxUs(0),
+      _loopTotalUs(0),
+      _lastTickUs(0),
+      _firstTick(true),
+      _minFreeHeap(UINT32_MAX),
+      _minLargestBlock(UINT32_MAX),
+      _queueDepthHighWater(0),
+      _lastPublishMs(0) {
+    memset(_loopHistogram, 0, sizeof(_loopHistogram));
+    memset(_stateResidencyMs, 0, sizeof(_stateResidencyMs));
+}
+
+void PerfTelemetryService::loopTick(int currentState) {
+    unsigned long nowUs = micros();
+
+    if (_firstTick) {
+        _firstTick = false;
+        _lastTickUs = nowUs;
+        return;
+    }
+
+    unsigned long iterationUs = nowUs - _lastTickUs;
+    _lastTickUs = nowUs;
+
+    // Loop latency histogram
+    size_t bin = LOOP_HISTOGRAM_BINS - 1;
+    for (size_t i = 0; i < LOOP_HISTOGRAM_BINS - 1; i++) {
+        if (iterationUs < LOOP_HISTOGRAM_BOUNDS_US[i]) {
+            bin = i;
+            break;
+        }
+    }
+    _loopHistogram[bin]++;
+    _loopCount++;
+    _loopTotalUs += iterationUs;
+    if (iterationUs > _loopMaxUs) {
+        _loopMaxUs = iterationUs;
+    }
+
+    // Attribute the iteration to the FSM state it ran in
+    if (currentState >= 0 && static_cast<size_t>(currentState) < MAX_TRACKED_STATES) {
+        _stateResidencyMs[currentState] += iterationUs / 1000;
+    }
+
+    // Heap minima (esp_get_minimum_free_heap_size is lifetime-min already;
+    // largest free block is the fragmentation signal)
+    uint32_t freeHeap = esp_get_free_heap_size();
+    if (freeHeap < _minFreeHeap) {
+        _minFreeHeap = freeHeap;
+    }
+    uint32_t largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    if (largestBlock < _minLargestBlock) {
+        _minLargestBlock = largestBlock;
+    }
+}
+
+void PerfTelemetryService::recordQueueDepth(size_t depth) {
+    if (depth > _queueDepthHighWater) {
+        _queueDepthHighWater = depth;
+    }
+}
+
+bool PerfTelemetryService::isTimeToPublish() const {
+    return (millis() - _lastPublishMs) >= TELEMETRY_PUBLISH_INTERVAL_MS;
+}
+
+uint32_t PerfTelemetryService::loopMaxUs() const {
+    return _loopMaxUs;
+}
+
+bool PerfTelemetryService::publish(MqttService& mqtt, const char* topic, const char* timestampIso) {
+    // Reset the timer even if the publish fails, so a broker hiccup doesn't
+    // make us hammer it every loop pass
+    _lastPublishMs = millis();
+
+    uint32_t avgUs = (_loopCount > 0) ? static_cast<uint32_t>(_loopTotalUs / _loopCount) : 0;
+
+    char payload[512];
+    int offset = snprintf(payload, sizeof(payload),
+                          "{\"timestamp_utc\":\"%s\",\"uptime_ms\":%lu,"
+                          "\"loop_count\":%lu,\"loop_avg_us\":%lu,\"loop_max_us\":%lu,"
+                          "\"heap_free\":%lu,\"heap_min_free\":%lu,\"heap_largest_block\":%lu,"
+                          "\"publish_queue_hwm\":%lu,\"loop_hist\":[",
+                          timestampIso,
+                          static_cast<unsigned long>(millis()),
+                          static_cast<unsigned long>(_loopCount),
+                          static_cast<unsigned long>(avgUs),
+                          static_cast<unsigned long>(_loopMaxUs),
+                          static_cast<unsigned long>(esp_get_free_heap_size()),
+                          static_cast<unsigned long>(_minFreeHeap),
+                          static_cast<unsigned long>(_minLargestBlock),
+                          static_cast<unsigned long>(_queueDepthHighWater));
+    if (offset <= 0 || static_cast<size_t>(offset) >= sizeof(payload)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < LOOP_HISTOGRAM_BINS; i++) {
+        int written = snprintf(payload + offset, sizeof(payload) - offset,
+                               "%s%lu", (i == 0) ? "" : ",",
+                               static_cast<unsigned long>(_loopHistogram[i]));
+        if (written <= 0 || static_cast<size_t>(written) >= sizeof(payload) - offset) {
+            return false;
+        }
+        offset += written;
+    }
+
+    int written = snprintf(payload + offset, sizeof(payload) - offset, "],\"state_ms\":[");
+    if (written <= 0 || static_cast<size_t>(written) >= sizeof(payload) - offset) {
+        return false;
+    }
+    offset += written;
+
+    for (size_t i = 0; i < MAX_TRACKED_STATES; i++) {
+        written = snprintf(payload + offset, sizeof(payload) - offset,
+                           "%s%lu", (i == 0) ? "" : ",",
+                           static_cast<unsigned long>(_stateResidencyMs[i]));
+        if (written <= 0 || static_cast<size_t>(written) >= sizeof(payload) - offset) {
+            return false;
+        }
+        offset += written;
+    }
+
+    written = snprintf(payload + offset, sizeof(payload) - offset, "]}");
+    if (written <= 0 || static_cast<size_t>(written) >= sizeof(payload) - offset) {
+        return false;
+    }
+
+    return mqtt.publishRaw(topic, payload);
+}
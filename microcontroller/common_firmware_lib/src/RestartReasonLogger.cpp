@@ -6,58 +6,89 @@
 const char* RestartReasonLogger::PREFERENCES_NAMESPACE = "restart";
 const char* RestartReasonLogger::REASON_KEY = "reason";
 const char* RestartReasonLogger::TIMESTAMP_KEY = "timestamp";
+const char* RestartReasonLogger::HISTORY_INDEX_KEY = "hist_idx";
+
+// RTC-noinit fast path: the restart event for the common warm-restart case
+// (every MAINTENANCE_RESTART, by design, forever) lives in RTC memory -
+// storing it costs nanoseconds instead of the tens-of-ms NVS flash commit,
+// and wears nothing. Checksummed so cold-boot garbage is never mistaken for
+// a stored event. NVS remains the read fallback (events written by older
+// firmware) and holds the persistent history ring.
+namespace {
+    struct RtcRestartEvent {
+        uint32_t reason;
+        char timestamp[25];     // ISO8601 or empty
+        uint8_t padding[3];
+        uint32_t checksum;
+    };
+
+    RTC_NOINIT_ATTR RtcRestartEvent g_rtcRestartEvent;
+
+    uint32_t rtcEventChecksum(const RtcRestartEvent& event) {
+        uint32_t checksum = 0x52525630u ^ event.reason; // "RRV0"
+        for (size_t i = 0; i < sizeof(event.timestamp); i++) {
+            checksum = (checksum * 31u) ^ static_cast<uint8_t>(event.timestamp[i]);
+        }
+        return checksum;
+    }
+
+    bool rtcEventValid() {
+        return g_rtcRestartEvent.checksum == rtcEventChecksum(g_rtcRestartEvent);
+    }
+}
 
 RestartReasonLogger::RestartReasonLogger() {
     // Constructor - no initialization needed
 }
 
 void RestartReasonLogger::storeRestartReason(RestartReason reason, NtpService& ntp) {
-    Preferences preferences;
-    
-    if (!preferences.begin(PREFERENCES_NAMESPACE, false)) {
-        Serial.println("RestartReasonLogger: Failed to open preferences for writing");
-        return;
-    }
-    
-    // Store the restart reason
-    preferences.putUInt(REASON_KEY, static_cast<uint32_t>(reason));
-    
-    // Store timestamp if NTP is available
-    String timestamp = "";
+    // Fast path: RTC-noinit memory only. Warm restarts (software resets,
+    // panics, watchdogs) read it back instantly on the next boot; no flash
+    // commit, no NVS sector wear on the restart path.
+    g_rtcRestartEvent.reason = static_cast<uint32_t>(reason);
+    memset(g_rtcRestartEvent.timestamp, 0, sizeof(g_rtcRestartEvent.timestamp));
+    memset(g_rtcRestartEvent.padding, 0, sizeof(g_rtcRestartEvent.padding));
+
     if (ntp.isTimeSet()) {
-        timestamp = ntp.getFormattedISO8601Time();
+        ntp.fillFormattedISO8601Time(g_rtcRestartEvent.timestamp, sizeof(g_rtcRestartEvent.timestamp));
         Serial.print("RestartReasonLogger: Storing restart reason with timestamp: ");
-        Serial.println(timestamp);
+        Serial.println(g_rtcRestartEvent.timestamp);
     } else {
         Serial.println("RestartReasonLogger: Storing restart reason without timestamp (NTP not available)");
     }
-    
-    preferences.putString(TIMESTAMP_KEY, timestamp);
-    preferences.end();
-    
+
+    g_rtcRestartEvent.checksum = rtcEventChecksum(g_rtcRestartEvent);
+
     Serial.print("RestartReasonLogger: Stored restart reason: ");
     Serial.println(restartReasonToString(reason));
 }
 
 RestartEvent RestartReasonLogger::getStoredRestartEvent() {
-    Preferences preferences;
     RestartEvent event;
-    
-    if (!preferences.begin(PREFERENCES_NAMESPACE, true)) {
-        Serial.println("RestartReasonLogger: Failed to open preferences for reading");
-        return event; // Returns default UNKNOWN_RESET with empty timestamp
+
+    if (rtcEventValid()) {
+        // Fast path: warm restart, event came through RTC memory
+        event.reason = static_cast<RestartReason>(g_rtcRestartEvent.reason);
+        event.timestamp = String(g_rtcRestartEvent.timestamp);
+        g_rtcRestartEvent.checksum = 0; // Consume (one-shot)
+    } else {
+        // Fallback: legacy NVS keys (events written by older firmware)
+        Preferences preferences;
+        if (!preferences.begin(PREFERENCES_NAMESPACE, true)) {
+            Serial.println("RestartReasonLogger: Failed to open preferences for reading");
+            return event; // Returns default UNKNOWN_RESET with empty timestamp
+        }
+
+        uint32_t storedReason = preferences.getUInt(REASON_KEY, static_cast<uint32_t>(UNKNOWN_RESET));
+        String storedTimestamp = preferences.getString(TIMESTAMP_KEY, "");
+        preferences.end();
+
+        event.reason = static_cast<RestartReason>(storedReason);
+        event.timestamp = storedTimestamp;
+
+        clearStoredRestartReason();
     }
-    
-    // Read the stored data
-    uint32_t storedReason = preferences.getUInt(REASON_KEY, static_cast<uint32_t>(UNKNOWN_RESET));
-    String storedTimestamp = preferences.getString(TIMESTAMP_KEY, "");
-    
-    preferences.end();
-    
-    // Create the event
-    event.reason = static_cast<RestartReason>(storedReason);
-    event.timestamp = storedTimestamp;
-    
+
     Serial.print("RestartReasonLogger: Retrieved restart reason: ");
     Serial.print(restartReasonToString(event.reason));
     if (event.timestamp != "") {
@@ -66,13 +97,75 @@ RestartEvent RestartReasonLogger::getStoredRestartEvent() {
     } else {
         Serial.println(" (no stored timestamp)");
     }
-    
-    // Clear the stored data immediately after reading (Option 1 from discussion)
-    clearStoredRestartReason();
-    
+
+    // Record the event in the persistent history ring (one small NVS write
+    // per boot - off the restart path, so no restart-time flash cost)
+    appendToHistory(event);
+
     return event;
 }
 
+void RestartReasonLogger::appendToHistory(const RestartEvent& event) {
+    Preferences preferences;
+    if (!preferences.begin(PREFERENCES_NAMESPACE, false)) {
+        return;
+    }
+
+    uint32_t index = preferences.getUInt(HISTORY_INDEX_KEY, 0);
+
+    char entryKey[16];
+    snprintf(entryKey, sizeof(entryKey), "hist_%u", static_cast<unsigned int>(index % HISTORY_SIZE));
+
+    // Entry format: "<reason>|<timestamp>" - compact and trivially parsed
+    String entry = restartReasonToString(event.reason) + "|" + event.timestamp;
+    preferences.putString(entryKey, entry);
+    preferences.putUInt(HISTORY_INDEX_KEY, index + 1);
+    preferences.end();
+}
+
+size_t RestartReasonLogger::getRestartHistory(RestartEvent* out, size_t maxEvents) {
+    Preferences preferences;
+    if (!preferences.begin(PREFERENCES_NAMESPACE, true)) {
+        return 0;
+    }
+
+    uint32_t nextIndex = preferences.getUInt(HISTORY_INDEX_KEY, 0);
+    size_t available = (nextIndex < HISTORY_SIZE) ? nextIndex : HISTORY_SIZE;
+    size_t count = 0;
+
+    // Walk newest-first
+    for (size_t i = 0; i < available && count < maxEvents; i++) {
+        uint32_t slot = (nextIndex - 1 - i) % HISTORY_SIZE;
+        char entryKey[16];
+        snprintf(entryKey, sizeof(entryKey), "hist_%u", static_cast<unsigned int>(slot));
+
+        String entry = preferences.getString(entryKey, "");
+        if (entry.length() == 0) {
+            continue;
+        }
+
+        int separator = entry.indexOf('|');
+        if (separator < 0) {
+            continue;
+        }
+
+        // History stores the human-readable slug; map it back best-effort
+        String reasonString = entry.substring(0, separator);
+        out[count].timestamp = entry.substring(separator + 1);
+        out[count].reason = UNKNOWN_RESET;
+        for (int r = UNKNOWN_RESET; r <= MAINTENANCE_RESTART; r++) {
+            if (reasonString == restartReasonToString(static_cast<RestartReason>(r))) {
+                out[count].reason = static_cast<RestartReason>(r);
+                break;
+            }
+        }
+        count++;
+    }
+
+    preferences.end();
+    return count;
+}
+
 PublishData RestartReasonLogger::createPublishData(NtpService& ntp, const char* topic, const char* uuid) {
     RestartEvent event = getStoredRestartEvent(); // This also clears storage
     
@@ -99,18 +192,22 @@ PublishData RestartReasonLogger::createPublishData(NtpService& ntp, const char*
 }
 
 bool RestartReasonLogger::hasStoredRestartReason() {
+    // Fast path: RTC event from a warm restart (no NVS open needed)
+    if (rtcEventValid()) {
+        return true;
+    }
+
+    // Fallback: legacy NVS keys
     Preferences preferences;
-    
+
     if (!preferences.begin(PREFERENCES_NAMESPACE, true)) {
         return false;
     }
-    
-    // Check if there's a stored reason (default value means no stored reason)
-    uint32_t storedReason = preferences.getUInt(REASON_KEY, static_cast<uint32_t>(UNKNOWN_RESET));
+
     bool hasReason = preferences.isKey(REASON_KEY);
-    
+
     preferences.end();
-    
+
     return hasReason;
 }
 
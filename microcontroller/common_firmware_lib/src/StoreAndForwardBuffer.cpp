@@ -0,0 +1,185 @@
+#include "services/StoreAndForwardBuffer.h"
+#include "services/MqttService.h"
+#include <LittleFS.h>
+
+const char* StoreAndForwardBuffer::RING_FILE_PATH = "/safb.dat";
+
+// Copy a String into a fixed record field, truncating if needed
+static void copyField(char* dest, size_t destSize, const char* src) {
+    if (src == nullptr) {
+        dest[0] = '\0';
+        return;
+    }
+    strncpy(dest, src, destSize - 1);
+    dest[destSize - 1] = '\0';
+}
+
+StoreAndForwardBuffer::StoreAndForwardBuffer()
+    : _available(false),
+      _droppedRecords(0) {
+    _header.magic = 0;
+    _header.head = 0;
+    _header.tail = 0;
+    _header.count = 0;
+}
+
+bool StoreAndForwardBuffer::begin() {
+    if (!LittleFS.begin(true)) {  // true = format on first mount failure
+        Serial.println("StoreAndForwardBuffer: LittleFS mount failed - buffering disabled");
+        return false;
+    }
+
+    _file = LittleFS.open(RING_FILE_PATH, "r+");
+    if (_file && _file.size() >= sizeof(Header)) {
+        // Existing ring file - validate the header
+        _file.seek(0);
+        if (_file.read(reinterpret_cast<uint8_t*>(&_header), sizeof(Header)) == sizeof(Header) &&
+            _header.magic == RING_MAGIC &&
+            _header.head < STORE_FORWARD_MAX_RECORDS &&
+            _header.tail < STORE_FORWARD_MAX_RECORDS &&
+            _header.count <= STORE_FORWARD_MAX_RECORDS) {
+            _available = true;
+            Serial.print("StoreAndForwardBuffer: ring file opened, ");
+            Serial.print(_header.count);
+            Serial.println(" buffered record(s) pending replay");
+            return true;
+        }
+        Serial.println("StoreAndForwardBuffer: invalid ring header - recreating");
+        _file.close();
+    }
+
+    // Create a fresh ring file with an empty header
+    _file = LittleFS.open(RING_FILE_PATH, "w+");
+    if (!_file) {
+        Serial.println("StoreAndForwardBuffer: could not create ring file - buffering disabled");
+        return false;
+    }
+
+    _header.magic = RING_MAGIC;
+    _header.head = 0;
+    _header.tail = 0;
+    _header.count = 0;
+    if (!writeHeader()) {
+        Serial.println("StoreAndForwardBuffer: header write failed - buffering disabled");
+        _file.close();
+        return false;
+    }
+
+    _available = true;
+    Serial.println("StoreAndForwardBuffer: ring file created");
+    return true;
+}
+
+bool StoreAndForwardBuffer::store(const PublishData& data) {
+    if (!_available) {
+        return false;
+    }
+
+    Record record;
+    copyField(record.topic, sizeof(record.topic), data.topic);
+    copyField(record.uuid, sizeof(record.uuid), data.uuid);
+    copyField(record.value, sizeof(record.value), data.serializedValue.c_str());
+    copyField(record.timestamp, sizeof(record.timestamp), data.timestampIsoUtc.c_str());
+    record.reserved = 0;
+
+    if (_header.count >= STORE_FORWARD_MAX_RECORDS) {
+        // Ring full - drop the oldest record to make room
+        _header.head = (_header.head + 1) % STORE_FORWARD_MAX_RECORDS;
+        _header.count--;
+        _droppedRecords++;
+    }
+
+    if (!writeRecord(_header.tail, record)) {
+        Serial.println("StoreAndForwardBuffer: record write failed");
+        return false;
+    }
+
+    _header.tail = (_header.tail + 1) % STORE_FORWARD_MAX_RECORDS;
+    _header.count++;
+    return writeHeader();
+}
+
+bool StoreAndForwardBuffer::isAvailable() const {
+    return _available;
+}
+
+bool StoreAndForwardBuffer::hasBufferedData() const {
+    return _available && _header.count > 0;
+}
+
+size_t StoreAndForwardBuffer::bufferedCount() const {
+    return _available ? _header.count : 0;
+}
+
+size_t StoreAndForwardBuffer::drain(MqttService& mqtt, size_t maxRecords) {
+    if (!_available || _header.count == 0) {
+        return 0;
+    }
+
+    size_t replayed = 0;
+    while (replayed < maxRecords && _header.count > 0) {
+        Record record;
+        if (!readRecord(_header.head, record)) {
+            Serial.println("StoreAndForwardBuffer: record read failed - dropping slot");
+            _header.head = (_header.head + 1) % STORE_FORWARD_MAX_RECORDS;
+            _header.count--;
+            _droppedRecords++;
+            writeHeader();
+            continue;
+        }
+
+        // Zero-allocation publish path; the record's timestamp is the
+        // original read time, so replayed data lands with correct timestamps
+        if (!mqtt.publishJson(record.topic, record.timestamp, record.uuid, record.value)) {
+            // Broker went away again - leave the record for the next drain
+            break;
+        }
+
+        _header.head = (_header.head + 1) % STORE_FORWARD_MAX_RECORDS;
+        _header.count--;
+        writeHeader();
+        replayed++;
+    }
+
+    if (replayed > 0) {
+        Serial.print("StoreAndForwardBuffer: replayed ");
+        Serial.print(replayed);
+        Serial.print(" record(s), ");
+        Serial.print(_header.count);
+        Serial.println(" remaining");
+    }
+    return replayed;
+}
+
+uint32_t StoreAndForwardBuffer::getDroppedRecordCount() const {
+    return _droppedRecords;
+}
+
+bool StoreAndForwardBuffer::writeHeader() {
+    if (!_file.seek(0)) {
+        return false;
+    }
+    if (_file.write(reinterpret_cast<const uint8_t*>(&_header), sizeof(Header)) != sizeof(Header)) {
+        return false;
+    }
+    _file.flush();
+    return true;
+}
+
+bool StoreAndForwardBuffer::readRecord(uint32_t slot, Record& record) {
+    if (!_file.seek(sizeof(Header) + slot * sizeof(Record))) {
+        return false;
+    }
+    return _file.read(reinterpret_cast<uint8_t*>(&record), sizeof(Record)) == sizeof(Record);
+}
+
+bool StoreAndForwardBuffer::writeRecord(uint32_t slot, const Record& record) {
+    if (!_file.seek(sizeof(Header) + slot * sizeof(Record))) {
+        return false;
+    }
+    if (_file.write(reinterpret_cast<const uint8_t*>(&record), sizeof(Record)) != sizeof(Record)) {
+        return false;
+    }
+    _file.flush();
+    return true;
+}
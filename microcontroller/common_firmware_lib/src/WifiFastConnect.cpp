@@ -0,0 +1,94 @@
+#include "services/WifiFastConnect.h"
+#include "utils/Log.h"
+#include <WiFi.h>
+#include <Preferences.h>
+
+const char* WifiFastConnect::PREFERENCES_NAMESPACE = "wifi_fast";
+const char* WifiFastConnect::PARAMS_KEY = "params";
+
+WifiFastConnect::WifiFastConnect()
+    : _fastPathAvailable(false),
+      _usedFastPath(false) {
+    memset(&_cache, 0, sizeof(_cache));
+}
+
+void WifiFastConnect::begin() {
+    Preferences preferences;
+    if (!preferences.begin(PREFERENCES_NAMESPACE, true)) {
+        // No cache yet - first boot, or NVS unavailable
+        return;
+    }
+
+    size_t read = preferences.getBytes(PARAMS_KEY, &_cache, sizeof(_cache));
+    preferences.end();
+
+    if (read == sizeof(_cache) && _cache.valid == CACHE_MAGIC) {
+        _fastPathAvailable = true;
+        LOG_INFO("WifiFastConnect: cached AP on channel %d available", _cache.channel);
+    }
+}
+
+void WifiFastConnect::startAttempt(const char* ssid, const char* password) {
+    if (_fastPathAvailable) {
+        // Static copy of the last DHCP lease skips the DHCP round trip;
+        // channel + BSSID skip the full scan
+        WiFi.config(IPAddress(_cache.ip), IPAddress(_cache.gateway),
+                    IPAddress(_cache.subnet), IPAddress(_cache.dns));
+        WiFi.begin(ssid, password, _cache.channel, _cache.bssid);
+        _usedFastPath = true;
+        LOG_INFO("WifiFastConnect: targeted connect (channel %d)", _cache.channel);
+    } else {
+        // Full scan + DHCP (all-zero config re-enables DHCP)
+        WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+        WiFi.begin(ssid, password);
+        _usedFastPath = false;
+        LOG_INFO("WifiFastConnect: full-scan connect");
+    }
+}
+
+void WifiFastConnect::onConnected() {
+    CachedParams current;
+    memset(&current, 0, sizeof(current));
+    current.valid = CACHE_MAGIC;
+
+    uint8_t* bssid = WiFi.BSSID();
+    if (bssid != nullptr) {
+        memcpy(current.bssid, bssid, 6);
+    }
+    current.channel = WiFi.channel();
+    current.ip = static_cast<uint32_t>(WiFi.localIP());
+    current.gateway = static_cast<uint32_t>(WiFi.gatewayIP());
+    current.subnet = static_cast<uint32_t>(WiFi.subnetMask());
+    current.dns = static_cast<uint32_t>(WiFi.dnsIP());
+
+    // The fast path is proven again for this boot (it may have been
+    // disabled by an earlier timeout before the full scan succeeded)
+    _fastPathAvailable = true;
+
+    if (memcmp(&current, &_cache, sizeof(current)) == 0) {
+        return; // Unchanged - skip the NVS write
+    }
+    _cache = current;
+
+    Preferences preferences;
+    if (!preferences.begin(PREFERENCES_NAMESPACE, false)) {
+        LOG_WARN("WifiFastConnect: could not persist connection parameters");
+        return;
+    }
+    preferences.putBytes(PARAMS_KEY, &_cache, sizeof(_cache));
+    preferences.end();
+
+    LOG_INFO("WifiFastConnect: cached AP parameters updated (channel %d)", _cache.channel);
+}
+
+void WifiFastConnect::onAttemptFailed() {
+    if (_fastPathAvailable && _usedFastPath) {
+        LOG_WARN("WifiFastConnect: targeted connect timed out - falling back to full scan");
+    }
+    // Disable for the rest of this boot; a later success re-validates it
+    _fastPathAvailable = false;
+}
+
+bool WifiFastConnect::usedFastPath() const {
+    return _usedFastPath;
+}
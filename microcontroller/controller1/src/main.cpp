@@ -8,14 +8,26 @@
 #include "services/MqttService.h" // For MQTT communication
 #include "PublishData.h" // For publish queue
 #include "services/RestartReasonLogger.h" // For persistent restart reason logging
+#include "services/NetworkTask.h" // For dual-core network servicing (ENABLE_DUAL_CORE_TASKS)
+#include "services/PerfTelemetryService.h" // Loop latency / heap / queue telemetry
+#include "services/OtaUpdateService.h" // MQTT-driven delta OTA updates
+#include "services/WifiFastConnect.h" // Cached BSSID/channel/lease fast reconnect
+#include "services/StoreAndForwardBuffer.h" // Flash-backed publish buffer for broker outages
+#include "services/DeepSleepScheduler.h" // Battery-mode deep sleep between read deadlines
 #include "sensors/SensorPoint.h" // Base sensor class
 #include "sensors/SHT85SensorPoint.h" // SHT85 sensor implementation
 #include "sensors/BME280SensorPoint.h" // BME280 sensor implementation
 #include "sensors/DHT22SensorPoint.h" // DHT22 sensor implementation
 #include "sensors/DS18B20SensorPoint.h" // DS18B20 sensor implementation
-#include "utils/UniqueQueue.h" // For duplicate-free queue management
+#include "utils/IntrusiveUniqueQueue.h" // Heap-free duplicate-free queue management
+#include "utils/StaticSensorRegistry.h" // Compile-time sensor registry (no heap, static dispatch)
+#include "utils/DeadlineScheduler.h" // Tickless idle: sleep until the next deadline
+#include "utils/ControllerRuntime.h" // Shared connectivity FSM (compile-time composition)
+#include "utils/Log.h" // Ring-buffered async logging
 #include "utils/I2cUtils.h" // For I2C debugging utilities
+#include "utils/I2cBusManager.h" // Fast-mode clocking, stuck-bus recovery, stats
 #include "utils/SensorPublishQueue.h" // For sensor publish queue management
+#include "utils/SensorReadScheduler.h" // Pipelined parallel two-phase reads
 #include <Wire.h> // For I2C
 #include <map>
 #include <queue>
@@ -29,15 +41,43 @@ using namespace FsmUtils;
 // SENSOR MANAGEMENT STRUCTURES
 // =============================================================================
 
-// Global vector to hold all sensor control points for this controller
+// Compile-time sensor registry: the sensors are constructed statically from
+// the autogen_config.h structs - no startup heap allocation, deterministic
+// RAM accounting, and registry iteration dispatches statically instead of
+// through the vtable. (DS18B20_0 intentionally not registered - see git history.)
+StaticSensorRegistry<SHT85SensorPoint, BME280SensorPoint, DHT22SensorPoint, DS18B20SensorPoint>
+    g_sensorRegistry(SHT85_0_CONFIG, BME280_1_CONFIG, DHT22_0_CONFIG, DS18B20_1_CONFIG);
+
+// Pointer view of the registry for code on the SensorPoint base interface
 std::vector<SensorPoint*> g_sensorPoints;
 
-// Queue of sensors that need to be read (prevents duplicates)
-UniqueQueue<SensorPoint*> g_sensorsToReadQueue;
+// Queue of sensors that need to be read (prevents duplicates via the
+// membership bit on SensorPoint - O(1), zero heap, static storage)
+IntrusiveUniqueQueue<SensorPoint, SensorReadScheduler::MAX_IN_FLIGHT> g_sensorsToReadQueue;
+
+// In-flight conversions (two-phase non-blocking reads). Conversions on
+// independent buses run concurrently; READ_SENSORS collects each one as its
+// ready deadline passes, keeping the loop responsive throughout.
+SensorReadScheduler g_readScheduler;
 
 // Global publish queue for all outgoing MQTT messages with sensor tracking
 SensorPublishQueue g_publishQueue;
 
+// I2C bus manager: fast-mode clock negotiation, stuck-bus recovery, and
+// per-device transaction stats
+I2cBusManager g_i2cBusManager;
+
+#if ENABLE_BATCHED_SENSOR_PUBLISH
+#ifndef SENSOR_BATCH_TOPIC
+#error "ENABLE_BATCHED_SENSOR_PUBLISH requires SENSOR_BATCH_TOPIC in build_flags"
+#endif
+// Batched publish queue: one entry per sensor read, all readings sharing one
+// timestamp (see BatchPublishData). Boot status etc. still use g_publishQueue.
+std::queue<BatchPublishData> g_batchPublishQueue;
+// Sensors with a batch waiting to publish (mirrors SensorPublishQueue tracking)
+std::set<SensorPoint*> g_sensorsWithBatchPending;
+#endif
+
 // =============================================================================
 // FSM STATE MANAGEMENT (ADR-17, ADR-22)
 // =============================================================================
@@ -49,14 +89,8 @@ unsigned long stateStartTime = 0;  // For state timeouts
 // FSM STATE ATTEMPT COUNTERS
 // =============================================================================
 
-// WiFi connection attempts
-static unsigned int wifiAttempts = 0;
-
-// NTP sync attempts  
-static unsigned int ntpAttempts = 0;
-
-// Boot status publishing flag to prevent duplicates/publishes false restarts
-static bool bootStatusPublished = false;
+// Connectivity attempt ladders, warm-recovery flags and the boot-status
+// guard now live in the shared ControllerRuntime (declared below)
 
 // =============================================================================
 // EXISTING CONFIGURATION AND SERVICES
@@ -70,6 +104,38 @@ MqttService mqttService(MQTT_CLIENT_ID, MQTT_BROKER_ADDRESS, MQTT_BROKER_PORT,
 // Restart reason logger for persistent error logging (ADR-14, ADR-17)
 RestartReasonLogger restartLogger;
 
+// On-device performance telemetry (loop latency, heap, queue depths),
+// published periodically on the diagnostics topic below
+PerfTelemetryService perfTelemetry;
+
+// Fast WiFi reconnect: targeted connect from cached BSSID/channel/lease,
+// falling back to the full scan when the targeted attempt times out
+WifiFastConnect wifiFastConnect;
+
+// MQTT-driven OTA updates (delta or full image); the FSM restarts into a
+// staged image with the FIRMWARE_UPDATE reason
+OtaUpdateService otaService;
+#ifndef OTA_CONTROL_TOPIC
+#define OTA_CONTROL_TOPIC "mush/" DEVICE_ID "/commands/ota/write"
+#endif
+#ifndef TELEMETRY_TOPIC
+#define TELEMETRY_TOPIC "mush/" DEVICE_ID "/statuses/perf_telemetry"
+#endif
+
+// Flash-backed store-and-forward buffer: the publish queue spills into this
+// while the broker is unreachable, and PUBLISH_DATA replays it on reconnect
+StoreAndForwardBuffer g_storeForwardBuffer;
+
+// How many buffered records to replay per PUBLISH_DATA pass (keeps the FSM
+// pass bounded while still draining an overnight backlog in a few minutes)
+#define STORE_FORWARD_DRAIN_BATCH 4
+
+#if ENABLE_DUAL_CORE_TASKS
+// Pinned FreeRTOS task on core 0 that services MQTT/NTP so the FSM on core 1
+// never waits behind a slow sensor bus (and vice versa)
+NetworkTask networkTask;
+#endif
+
 // How often to attempt NTP update in the loop (milliseconds)
 unsigned long lastNtpLoopUpdate = 0;
 
@@ -82,47 +148,81 @@ unsigned long lastPeriodicCheck = 0;
 
 
 void setupSensors() {
-    Serial.println("Creating sensor instances...");
-    
-    // === I2C Sensors ===
-    // SHT85 Temperature/Humidity Sensor (I2C address 0x44)
-    g_sensorPoints.push_back(new SHT85SensorPoint(SHT85_0_CONFIG));
-    Serial.println("Created SHT85 sensor (FruitingChamber)");
-    
-    // BME280 Temperature/Humidity/Pressure Sensor (I2C address 0x77)
-    g_sensorPoints.push_back(new BME280SensorPoint(BME280_1_CONFIG));
-    Serial.println("Created BME280 sensor (FruitingChamber)");
-    
-    // === DHT Sensors ===
-    // DHT22 Temperature/Humidity Sensor (Digital pin 27)
-    g_sensorPoints.push_back(new DHT22SensorPoint(DHT22_0_CONFIG));
-    Serial.println("Created DHT22 sensor (Outside)");
-    
-    // === OneWire Sensors ===
-    // DS18B20 Temperature Sensors (Digital pins 32 and 33)
-    g_sensorPoints.push_back(new DS18B20SensorPoint(DS18B20_1_CONFIG));
-    Serial.println("Created DS18B20_1 sensor (FruitingChamber)");
-    
-    // g_sensorPoints.push_back(new DS18B20SensorPoint(DS18B20_0_CONFIG));
-    // Serial.println("Created DS18B20_0 sensor (FruitingChamber)");
-    
-    Serial.print("Total sensors created: ");
+    Serial.println("Registering sensor instances (static, no heap)...");
+
+    // Pointer view of the statically constructed registry for code that works
+    // with the SensorPoint base interface (read queue, publish tracking)
+    g_sensorPoints.resize(g_sensorRegistry.size());
+    g_sensorRegistry.fillPointerArray(g_sensorPoints.data());
+
+    Serial.print("Total sensors registered: ");
     Serial.println(g_sensorPoints.size());
 }
 
-void checkSensorsNeedingRead() {
-    
-    for (SensorPoint* sensor : g_sensorPoints) {
-        // Check if sensor already has data waiting to publish
-        if (!g_publishQueue.hasPendingData(sensor) && sensor->needToRead(millis())) {
-            if (g_sensorsToReadQueue.tryEnqueue(sensor)) {
+// Visitor for SETUP_HW: statically dispatched initialize() on every sensor
+struct SensorInitVisitor {
+    bool allInitialized;
+    SensorInitVisitor() : allInitialized(true) {}
+
+    template<typename SensorT>
+    void operator()(SensorT& sensor) {
+        if (!sensor.initialize()) {
+            // Warm tier: one per-sensor retry before the blanket
+            // SENSOR_INIT_FAILED restart
+            LOG_WARN("Retrying initialization for %s", sensor.getPointName());
+            delay(100);
+            if (!sensor.initialize()) {
+                allInitialized = false;
+            }
+        }
+    }
+};
+
+// Visitor for checkSensorsNeedingRead(): statically dispatched timing checks
+struct SensorReadCheckVisitor {
+    template<typename SensorT>
+    void operator()(SensorT& sensor) {
+#if ENABLE_BATCHED_SENSOR_PUBLISH
+        // Skip sensors whose batch is still waiting to publish
+        if (g_sensorsWithBatchPending.find(&sensor) != g_sensorsWithBatchPending.end()) {
+            return;
+        }
+#endif
+        // Check if sensor already has data waiting to publish or a read converting
+        if (!g_publishQueue.hasPendingData(&sensor) && !sensor.isReadInFlight() && sensor.needToRead(millis())) {
+            if (g_sensorsToReadQueue.tryEnqueue(&sensor)) {
                 Serial.println("Sensor queued for reading");
             }
             // If tryEnqueue returns false, sensor was already queued - no action needed
         }
     }
+};
+
+void checkSensorsNeedingRead() {
+    SensorReadCheckVisitor visitor;
+    g_sensorRegistry.forEach(visitor);
 }
 
+// Compile-time controller composition for the shared runtime: sensor-only,
+// so the command subsystem never exists here - the onMqttConnected() hook
+// inlines to nothing
+struct C1RuntimeTraits {
+    static const char* lastRestartReasonTopic() { return TOPIC_C1_LastRestartReason_DATA; }
+    static const char* lastRestartReasonUuid() { return UUID_C1_LastRestartReason_DATA; }
+    static const char* otaControlTopic() { return OTA_CONTROL_TOPIC; }
+    static FsmState idleWorkState() { return READ_SENSORS; }
+    static void onMqttConnected() {} // Sensor-only - nothing to subscribe
+    static void queueForPublish(const PublishData& data) { g_publishQueue.queueForPublish(data); }
+    // Flash buffering is live: the runtime yields to WAIT between MQTT
+    // attempts (keeping READ_SENSORS reachable) and defers the
+    // MQTT_TIMEOUT restart while the outage data is being captured
+    static bool bufferingWhileDisconnected() { return g_storeForwardBuffer.isAvailable(); }
+};
+
+// Shared connectivity FSM (WiFi/NTP/MQTT ladders, warm recovery, boot status)
+ControllerRuntime<C1RuntimeTraits> g_runtime(ntpService, mqttService, restartLogger,
+                                             wifiFastConnect, otaService);
+
 // =============================================================================
 // DEBUG HELPER FUNCTIONS
 // =============================================================================
@@ -130,6 +230,43 @@ void checkSensorsNeedingRead() {
 void printPublishQueueStatus() {
     Serial.print("Publish queue size: ");
     Serial.println(g_publishQueue.size());
+#if ENABLE_BATCHED_SENSOR_PUBLISH
+    Serial.print("Batch publish queue size: ");
+    Serial.println(g_batchPublishQueue.size());
+#endif
+}
+
+// Move everything waiting in the RAM publish queue into the flash ring so a
+// broker outage (or the restart ladder) can't lose it. Clears the sensors'
+// pending flags so sampling continues while disconnected. (Batch-mode
+// entries stay in RAM: batch entries carry no per-reading topic, so they
+// can't be represented as single flash records.)
+void spillPublishQueueToFlash() {
+    if (!g_storeForwardBuffer.isAvailable()) {
+        return; // No flash ring - keep the items in RAM rather than drop them
+    }
+
+    while (!g_publishQueue.empty()) {
+        PublishData item = g_publishQueue.dequeueForPublish();
+        if (g_storeForwardBuffer.store(item) && item.sourceSensor != nullptr) {
+            // A durably captured reading satisfies the no-publish watchdog:
+            // restarting mid-outage would only interrupt the sampling the
+            // buffer exists to preserve
+            item.sourceSensor->updateLastPublishTime(millis());
+        }
+        g_publishQueue.markPublishComplete(item);
+    }
+}
+
+// True if anything (single readings, batches, or flash-buffered records)
+// is waiting to publish
+bool hasPublishWork() {
+#if ENABLE_BATCHED_SENSOR_PUBLISH
+    if (!g_batchPublishQueue.empty()) {
+        return true;
+    }
+#endif
+    return !g_publishQueue.empty() || g_storeForwardBuffer.hasBufferedData();
 }
 
 void printSensorStatus() {
@@ -152,14 +289,37 @@ void setup() {
     while (!Serial); // Wait for serial to connect (especially for some boards)
     Serial.println("\n\n--- Controller C1 (Sensor Controller) Starting ---");
 
+#if ENABLE_DEEP_SLEEP_MODE
+    if (DeepSleepScheduler::isTimerWake()) {
+        Serial.println("Woke from scheduled deep sleep");
+        // Re-seed the clock from RTC memory so SYNC_NTP passes immediately,
+        // and skip the boot-status publish (a scheduled wake is not a restart)
+        DeepSleepScheduler::restoreCarriedTime();
+        g_runtime.markBootStatusPublished();
+    }
+#endif
+
     // Hardware initialization only - connectivity handled by FSM
     setupSensors();
     
+    Serial.println("Initializing store-and-forward buffer...");
+    g_storeForwardBuffer.begin(); // Non-fatal on failure - buffering just stays disabled
+
+    // Load cached WiFi parameters for the targeted fast-connect path
+    wifiFastConnect.begin();
+
     Serial.println("Initializing MQTT Service...");
     mqttService.begin();// Sets server and callback, does not connect
+    mqttService.setOtaService(&otaService); // Route OTA messages to the updater
     
     // Note: C1 doesn't need command management like C2 since it's sensor-only
 
+#if ENABLE_DUAL_CORE_TASKS
+    // Dual-core mode: MQTT/NTP servicing runs pinned to core 0, the FSM below
+    // keeps core 1. MqttService's internal mutex makes the split safe.
+    networkTask.begin(mqttService, ntpService);
+#endif
+
     Serial.println("Setup complete. Entering main FSM loop...");
     Serial.println("FSM will handle: SETUP_HW -> WiFi -> NTP -> MQTT -> Boot Status -> Normal Operation");
     lastNtpLoopUpdate = millis(); // Initialize for loop updates
@@ -170,7 +330,9 @@ void setup() {
 void loop() {
     unsigned long currentTime = millis();// Note this is not sufficient for timing that must account for blocking operations, but is good enough for FSM timing.
 
-    mqttService.loop(); // Process MQTT messages and maintain connection
+#if !ENABLE_DUAL_CORE_TASKS
+    mqttService.loop(); // Process MQTT messages and maintain connection (NetworkTask owns this in dual-core mode)
+#endif
     // Always check for sensors needing to be read for better timing. Our awareness of when things should be read should not be dependent on the FSM. 
     checkSensorsNeedingRead();
     // Main FSM Logic
@@ -179,12 +341,12 @@ void loop() {
         case SETUP_HW:
             Serial.println("State: SETUP_HW");
             
-            // Initialize I2C bus
-            Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
-            Serial.print("I2C initialized on SDA:");
-            Serial.print(I2C_SDA_PIN);
-            Serial.print(", SCL:");
-            Serial.println(I2C_SCL_PIN);
+            // Initialize I2C through the bus manager: registers each
+            // device's clock capability, recovers a stuck bus (SDA held
+            // low) with clock pulses, and runs fast mode where possible
+            g_i2cBusManager.registerDevice(SHT85_0_CONFIG.address, SHT85_0_CONFIG.i2c_max_clock_hz);
+            g_i2cBusManager.registerDevice(BME280_1_CONFIG.address, BME280_1_CONFIG.i2c_max_clock_hz);
+            g_i2cBusManager.begin(I2C_SDA_PIN, I2C_SCL_PIN);
             
             // Scan I2C bus to check for hardware issues (if enabled in config)
             #if DEBUG_I2C_SCAN_ON_STARTUP
@@ -193,8 +355,11 @@ void loop() {
             
             // Initialize all sensor hardware - fail fast on any failure
             Serial.println("Initializing sensor hardware...");
-            for (SensorPoint* sensor : g_sensorPoints) {
-                if (!sensor->initialize()) {
+            {
+                // Statically dispatched through the registry - no vtable
+                SensorInitVisitor initVisitor;
+                g_sensorRegistry.forEach(initVisitor);
+                if (!initVisitor.allInitialized) {
                     Serial.println("CRITICAL: Sensor initialization failed - restarting controller");
                     handleRestartWithReason(currentState, SENSOR_INIT_FAILED, restartLogger, ntpService);
                     return; // Exit immediately, don't continue with loop
@@ -206,179 +371,119 @@ void loop() {
             break;
 
         case CONNECT_WIFI:
-            
-            // Check if WiFi is already connected
-            if (WiFi.status() == WL_CONNECTED) {
-                Serial.println("WiFi connected successfully!");
-                Serial.print("IP Address: ");
-                Serial.println(WiFi.localIP());
-                resetRetries(wifiAttempts, "WiFi");
-                transitionToState(currentState, SYNC_NTP, stateStartTime, true); // New operation - reset timer
-                break;
-            }
-            
-            // Check if this is a new attempt or timeout
-            if (wifiAttempts == 0 || checkTimeout(stateStartTime, WIFI_ATTEMPT_TIMEOUT_MS)) {
-                if (checkAndIncrementRetries(wifiAttempts, MAX_WIFI_ATTEMPTS, "WiFi")) {
-                    handleRestartWithReason(currentState, WIFI_TIMEOUT, restartLogger, ntpService);
-                    break;
-                }
-                
-                // Start new WiFi attempt
-                Serial.print(" - Connecting to: ");
-                Serial.println(WIFI_SSID);
-                
-                WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-                stateStartTime = currentTime; // Manual reset for new attempt timer
-            } else {
-                // Still waiting for current attempt
-                Serial.print(".");
-            }
+            g_runtime.handleConnectWifi(currentState, stateStartTime, currentTime);
             break;
 
         case SYNC_NTP:
-            // Initialize NTP service if this is the first attempt
-            if (ntpAttempts == 0) {
-                Serial.println("Initializing NTP Service...");
-                ntpService.begin();
-                ntpAttempts = 1;
-                stateStartTime = currentTime;
-            }
-            
-            // Try to update/sync NTP
-            ntpService.update();
-            
-            // Check if NTP is now synchronized
-            if (ntpService.isTimeSet()) {
-                Serial.println("NTP sync successful!");
-                Serial.print("Current UTC Time: ");
-                Serial.println(ntpService.getFormattedISO8601Time());
-                Serial.print("Current Epoch Time: ");
-                Serial.println(ntpService.getEpochTime());
-                resetRetries(ntpAttempts, "NTP");
-                transitionToState(currentState, CONNECT_MQTT, stateStartTime, true); // New operation - reset timer
-                break;
-            }
-            
-            // Check for timeout on current attempt
-            if (checkTimeout(stateStartTime, NTP_ATTEMPT_TIMEOUT_MS)) {
-                if (checkAndIncrementRetries(ntpAttempts, MAX_NTP_ATTEMPTS, "NTP")) {
-                    handleRestartWithReason(currentState, NTP_TIMEOUT, restartLogger, ntpService);
-                    break;
-                }
-                
-                // Start new NTP attempt
-                Serial.println(" - Retrying...");
-                stateStartTime = currentTime; // Manual reset for new attempt timer
-            } else {
-                // Still waiting for current attempt
-                Serial.print("n"); // NTP attempt indicator
-            }
+            g_runtime.handleSyncNtp(currentState, stateStartTime, currentTime);
             break;
 
         case CONNECT_MQTT:
-            if (mqttService.connectBroker()) {
-                Serial.println("MQTT connected successfully!");
-                // Note: C1 doesn't need to subscribe to any topics since it's sensor-only
-                
-                // Only publish boot status if we haven't already
-                if (!bootStatusPublished) {
-                    transitionToState(currentState, PUBLISH_BOOT_STATUS, stateStartTime);
-                } else {
-                    transitionToState(currentState, READ_SENSORS, stateStartTime);
-                }
-            } else {
-                Serial.println("MQTT connection failed, retrying...");
-                
-                // Check for MQTT timeout (using constant from autogen_config.h)
-                if (checkTimeout(stateStartTime, MQTT_CONNECT_TIMEOUT_MS)) {
-                    handleRestartWithReason(currentState, MQTT_TIMEOUT, restartLogger, ntpService);
-                } else {
-                    transitionToState(currentState, CONNECT_MQTT, stateStartTime); // Stay in this state, keep timer
-                    delay(MQTT_RETRY_DELAY_MS); // Retry delay from autogen_config.h
-                }
-            }
+            g_runtime.handleConnectMqtt(currentState, stateStartTime, currentTime);
             break;
 
-        case PUBLISH_BOOT_STATUS: {
-            // Always publish a restart reason - default to unknown if none stored
-            PublishData bootStatus;
-            if (restartLogger.hasStoredRestartReason()) {
-                Serial.println("Found stored restart reason, creating publish data...");
-                bootStatus = restartLogger.createPublishData(
-                    ntpService,
-                    TOPIC_C1_LastRestartReason_DATA,
-                    UUID_C1_LastRestartReason_DATA
-                );
-            } else {
-                Serial.println("No stored restart reason found, defaulting to unknown_reset");
-                // Create PublishData for unknown restart reason
-                String timestamp = ntpService.getFormattedISO8601Time();
-                String reasonString = RestartReasonLogger::restartReasonToString(UNKNOWN_RESET);
-                bootStatus = PublishData(
-                    TOPIC_C1_LastRestartReason_DATA,
-                    UUID_C1_LastRestartReason_DATA,
-                    reasonString,
-                    timestamp
-                );
-            }
-            
-            g_publishQueue.queueForPublish(bootStatus);
-            Serial.println("Restart reason queued for publishing");
-            
-            // Mark boot status as published and transition to normal operation
-            bootStatusPublished = true;
-            transitionToState(currentState, READ_SENSORS, stateStartTime);
+        case PUBLISH_BOOT_STATUS:
+            g_runtime.handlePublishBootStatus(currentState, stateStartTime);
             break;
-        }
 
         case READ_SENSORS:
-            if (!g_sensorsToReadQueue.empty()) {
-                SensorPoint* sensor = g_sensorsToReadQueue.dequeue();
-                
-                Serial.println("Reading sensor...");
-                sensor->updateLastReadAttempt(millis());
-                
-                // Capture timestamp just before reading sensor
-                String readTimestamp = ntpService.getFormattedISO8601Time();
-                
-                // DEBUG: Start timing the sensor read
-                unsigned long readStartTime = millis();
-                Serial.print("Starting sensor read at: ");
-                Serial.println(readStartTime);
-                
-                if (sensor->read(readTimestamp)) {  // Pass timestamp for sensor to store
-                    // DEBUG: End timing the sensor read
-                    unsigned long readEndTime = millis();
-                    unsigned long readDuration = readEndTime - readStartTime;
-                    Serial.print("Sensor read completed in: ");
-                    Serial.print(readDuration);
-                    Serial.println(" ms");
-                    
-                    Serial.println("Sensor read successful, packaging readings...");
-                    auto readings = sensor->getAllReadings();
-                    
-                    for (const auto& reading : readings) {
-                        PublishData pub(reading.topic, reading.uuid, reading.value, reading.timestamp, sensor);
-                        g_publishQueue.queueForPublish(pub);
-                        Serial.print("Queued: ");
-                        Serial.print(reading.topic);
-                        Serial.print(" = ");
-                        Serial.println(reading.value);
+            if (g_readScheduler.anyReady(currentTime)) {
+                // Phase 2: collect the first ready conversion
+                SensorPoint* sensor = g_readScheduler.takeReady(currentTime);
+
+                if (sensor->finishRead()) {
+                    sensor->recordReadSuccess();
+                    LOG_DEBUG("Sensor read successful, packaging readings...");
+
+                    // Allocation-free delivery: typed values into a fixed
+                    // inline array, shared timestamp from the base class,
+                    // formatting deferred to the publish slot
+                    ReadingView views[PUBLISH_BATCH_MAX_READINGS];
+                    size_t viewCount = sensor->getReadingViews(views, PUBLISH_BATCH_MAX_READINGS);
+
+                    if (sensor->isAggregating()) {
+                        // Oversampling mode: fold this sample into the
+                        // streaming aggregates; publish only when the
+                        // publish interval elapses, with the mean values
+                        sensor->accumulateSample(views, viewCount);
+                        if (!sensor->isTimeToPublishAggregate(currentTime)) {
+                            transitionToState(currentState, WAIT, stateStartTime);
+                            break;
+                        }
+                        sensor->buildAggregatedReadings(views, viewCount);
+                        LOG_DEBUG("Publishing aggregated readings...");
                     }
-                    
+
+                    // Change-of-value mode: suppress the publish when no
+                    // channel moved beyond its deadband and the heartbeat
+                    // isn't due (the heartbeat keeps the no-publish watchdog
+                    // and downstream consumers alive)
+                    if (!sensor->shouldPublishCov(views, viewCount, currentTime)) {
+                        sensor->recordCovSuppressed(currentTime);
+                        LOG_DEBUG("CoV: reading within deadband - publish suppressed");
+                        transitionToState(currentState, WAIT, stateStartTime);
+                        break;
+                    }
+                    sensor->recordCovBaseline(views, viewCount);
+
+#if ENABLE_BATCHED_SENSOR_PUBLISH
+                    // One batched message per sensor read, shared timestamp
+                    if (viewCount > 0) {
+                        BatchPublishData batch(SENSOR_BATCH_TOPIC, String(sensor->getReadingTimestamp()), sensor);
+                        for (size_t i = 0; i < viewCount; i++) {
+                            char valueBuffer[16];
+                            dtostrf(views[i].value, 0, views[i].decimals, valueBuffer);
+                            batch.addEntry(views[i].uuid, String(valueBuffer));
+                        }
+                        g_batchPublishQueue.push(batch);
+                        g_sensorsWithBatchPending.insert(sensor);
+                        LOG_DEBUG("Queued batch of %u readings",
+                                  static_cast<unsigned int>(batch.entryCount));
+                    }
+#else
+                    for (size_t i = 0; i < viewCount; i++) {
+                        g_publishQueue.queueReading(views[i].topic, views[i].uuid,
+                                                    views[i].value, views[i].decimals,
+                                                    sensor->getReadingTimestamp(), sensor);
+                        LOG_DEBUG("Queued: %s = %.*f", views[i].topic,
+                                  static_cast<int>(views[i].decimals), views[i].value);
+                    }
+#endif
+
                     // DON'T update last publish time here - that should happen when MQTT actually publishes!
                 } else {
-                    // DEBUG: End timing even for failed reads
-                    unsigned long readEndTime = millis();
-                    unsigned long readDuration = readEndTime - readStartTime;
-                    Serial.print("Sensor read FAILED after: ");
-                    Serial.print(readDuration);
-                    Serial.println(" ms");
-                    
-                    Serial.println("Sensor read failed - will retry next cycle");
+                    sensor->recordReadFailure();
+                    if (sensor->needsReinitialize()) {
+                        // Warm tier: reinitialize just this sensor instead of
+                        // riding the failure streak into a NOPUBLISH reboot
+                        LOG_WARN("Warm recovery: reinitializing %s after repeated read failures",
+                                 sensor->getPointName());
+                        sensor->initialize();
+                        sensor->recordReadSuccess(); // Restart the failure count
+                    }
+                    LOG_WARN("Sensor read failed - will retry next cycle");
+                }
+
+                // Always transition to WAIT to let FSM decide what's next
+                transitionToState(currentState, WAIT, stateStartTime);
+            } else if (!g_sensorsToReadQueue.empty() && g_readScheduler.hasCapacity()) {
+                // Phase 1: start the next queued conversion - conversions on
+                // independent buses pipeline while earlier ones are still
+                // converting, so a burst costs max(conversion times), not the sum
+                SensorPoint* sensor = g_sensorsToReadQueue.dequeue();
+
+                LOG_DEBUG("Starting sensor read...");
+                sensor->updateLastReadAttempt(currentTime);
+
+                // Capture timestamp just before starting the measurement
+                String readTimestamp = ntpService.getFormattedISO8601Time();
+
+                if (sensor->startRead(readTimestamp)) {
+                    g_readScheduler.track(sensor);
+                } else {
+                    LOG_WARN("Sensor read start failed - will retry next cycle");
                 }
-                
+
                 // Always transition to WAIT to let FSM decide what's next
                 transitionToState(currentState, WAIT, stateStartTime);
             } else {
@@ -388,37 +493,86 @@ void loop() {
             break;
 
         case PUBLISH_DATA:
-            // Check MQTT connection first - if not connected, transition to reconnect
+            // Check MQTT connection first - if not connected, spill the pending
+            // readings to flash (so the outage doesn't lose them and sensors
+            // keep sampling) and transition to reconnect
             if (!mqttService.isConnected()) {
-                Serial.println("MQTT not connected in PUBLISH_DATA state - transitioning to CONNECT_MQTT");
+                spillPublishQueueToFlash();
+                LOG_WARN("MQTT not connected in PUBLISH_DATA state - transitioning to CONNECT_MQTT");
                 transitionToState(currentState, CONNECT_MQTT, stateStartTime);
                 break;
             }
+
+            // Replay flash-buffered records first (oldest data lands first);
+            // bounded per pass so the loop stays responsive
+            if (g_storeForwardBuffer.hasBufferedData()) {
+                g_storeForwardBuffer.drain(mqttService, STORE_FORWARD_DRAIN_BATCH);
+                transitionToState(currentState, WAIT, stateStartTime);
+                break;
+            }
             
-            if (!g_publishQueue.empty()) {
-                PublishData item = g_publishQueue.dequeueForPublish();
-                
-                Serial.print("Publishing to ");
-                Serial.print(item.topic);
-                Serial.print(": ");
-                Serial.print(item.serializedValue);
-                Serial.print(" at ");
-                Serial.println(item.timestampIsoUtc);
-                
-                // Publish via MQTT using publishJson with the raw value
-                if (mqttService.publishJson(item.topic, item.timestampIsoUtc, item.uuid, item.serializedValue)) {
-                    Serial.println("Publish successful!");
-                    
-                    // Update sensor last publish time and remove from tracking
-                    if (item.sourceSensor != nullptr) {
-                        item.sourceSensor->updateLastPublishTime(millis());
+#if ENABLE_BATCHED_SENSOR_PUBLISH
+            if (!g_batchPublishQueue.empty()) {
+                BatchPublishData batch = g_batchPublishQueue.front();
+                g_batchPublishQueue.pop();
+                g_sensorsWithBatchPending.erase(batch.sourceSensor);
+
+                LOG_DEBUG("Publishing batch to %s (%u readings) at %s",
+                          batch.topic, static_cast<unsigned int>(batch.entryCount),
+                          batch.timestampIsoUtc.c_str());
+
+                if (mqttService.publishJsonBatch(batch.topic, batch.timestampIsoUtc.c_str(),
+                                                 batch.entries, batch.entryCount)) {
+                    LOG_DEBUG("Batch publish successful!");
+                    if (batch.sourceSensor != nullptr) {
+                        batch.sourceSensor->updateLastPublishTime(millis());
                     }
-                    g_publishQueue.markPublishComplete(item);
                 } else {
-                    Serial.println("Publish failed!");
+                    LOG_WARN("Batch publish failed!");
                     // For now, just continue - could implement retry logic later
                 }
-                
+
+                // Always transition to WAIT to let FSM decide what's next
+                transitionToState(currentState, WAIT, stateStartTime);
+                break;
+            }
+#endif
+            if (!g_publishQueue.empty()) {
+                // Batch drain: keep publishing until the queue is empty or the
+                // time budget is spent, so a multi-reading burst reaches the
+                // broker in one pass instead of one item per loop period
+                unsigned long drainStart = millis();
+                while (!g_publishQueue.empty() &&
+                       (millis() - drainStart) < PUBLISH_DRAIN_BUDGET_MS &&
+                       mqttService.isConnected()) {
+                    // Zero-copy view into the pooled slot - no PublishData
+                    // copy, no String allocations on the publish path
+                    const SensorPublishQueue::Entry* item = g_publishQueue.peekFront();
+
+                    LOG_DEBUG("Publishing to %s: %s at %s",
+                              item->topic, item->serializedValue, item->timestampIsoUtc);
+
+                    // Publish via MQTT using the zero-allocation publishJson path
+                    if (mqttService.publishJson(item->topic, item->timestampIsoUtc, item->uuid, item->serializedValue)) {
+                        LOG_DEBUG("Publish successful!");
+
+                        // Update sensor last publish time and remove from tracking
+                        if (item->sourceSensor != nullptr) {
+                            item->sourceSensor->updateLastPublishTime(millis());
+                        }
+                        g_publishQueue.markPublishComplete(*item);
+                        g_publishQueue.popFront();
+                    } else {
+                        LOG_WARN("Publish failed!");
+                        // The item is dropped - clear the sensor's pending
+                        // flag like the overflow path does, or the sensor
+                        // would never be re-queued for reading
+                        g_publishQueue.markPublishComplete(*item);
+                        g_publishQueue.popFront();
+                        break;
+                    }
+                }
+
                 // Always transition to WAIT to let FSM decide what's next
                 transitionToState(currentState, WAIT, stateStartTime);
             } else {
@@ -428,8 +582,18 @@ void loop() {
             break;
 
         case OPERATIONAL_PERIODIC_CHECKS:
-            // Check for maintenance restart interval (millis() overflow prevention)
-            if (currentTime >= MAINTENANCE_RESTART_INTERVAL_MS) {
+            // Restart into a staged OTA update (FIRMWARE_UPDATE reason keeps
+            // the restart history honest and pairs with bootloader rollback)
+            if (otaService.isReadyToReboot()) {
+                Serial.println("Staged OTA update ready - restarting into new image");
+                restartLogger.storeRestartReason(FIRMWARE_UPDATE, ntpService);
+                transitionToState(currentState, RESTART, stateStartTime);
+                break;
+            }
+
+            // Check for maintenance restart interval (millis() overflow
+            // prevention) - deferred while an OTA transfer is streaming
+            if (currentTime >= MAINTENANCE_RESTART_INTERVAL_MS && !otaService.isTransferActive()) {
                 Serial.println("Maintenance restart interval reached - scheduling restart");
                 // Store restart reason for next boot
                 restartLogger.storeRestartReason(MAINTENANCE_RESTART, ntpService);
@@ -437,9 +601,17 @@ void loop() {
                 break;
             }
             
+            // I2C bus health: recover a wedged bus without a power cycle,
+            // probe registered devices (feeds the timing/error stats), and
+            // log the per-device summary
+            if (g_i2cBusManager.isBusStuck()) {
+                g_i2cBusManager.recoverBus();
+            }
+            g_i2cBusManager.probeRegisteredDevices();
+            g_i2cBusManager.logStats();
+
             // TODO: Add other periodic maintenance tasks here:
             // - Memory usage checks
-            // - Sensor health diagnostics
             // - WiFi signal strength monitoring
             // - MQTT connection quality checks
             
@@ -460,20 +632,47 @@ void loop() {
             if (!isWiFiConnected()) {
                 transitionToState(currentState, CONNECT_WIFI, stateStartTime);
             } else if (!isMqttConnected()) {
-                transitionToState(currentState, CONNECT_MQTT, stateStartTime);
+                // Broker outage: spill pending readings to flash right where
+                // the disconnect is detected, and keep sensor work reachable
+                // so sampling continues through the outage - new readings
+                // land in the queue and spill on the next pass, replaying
+                // after reconnect
+                spillPublishQueueToFlash();
+                if (g_readScheduler.anyReady(currentTime) ||
+                    (!g_sensorsToReadQueue.empty() && g_readScheduler.hasCapacity())) {
+                    transitionToState(currentState, READ_SENSORS, stateStartTime);
+                } else {
+                    transitionToState(currentState, CONNECT_MQTT, stateStartTime);
+                }
             }
             // Check for periodic maintenance tasks
             else if (currentTime - lastPeriodicCheck >= PERIODIC_CHECKS_INTERVAL_MS) {
                 transitionToState(currentState, OPERATIONAL_PERIODIC_CHECKS, stateStartTime);
             }
+            // Check if an in-flight sensor conversion is ready to collect
+            else if (g_readScheduler.anyReady(currentTime)) {
+                transitionToState(currentState, READ_SENSORS, stateStartTime);
+            }
             // Check for work to do
-            else if (!g_publishQueue.empty()) {
+            else if (hasPublishWork()) {
                 transitionToState(currentState, PUBLISH_DATA, stateStartTime);
             } else {
-                if (!g_sensorsToReadQueue.empty()) {
+                if (!g_sensorsToReadQueue.empty() && g_readScheduler.hasCapacity()) {
+                    // Start more conversions even while others are in flight
                     transitionToState(currentState, READ_SENSORS, stateStartTime);
                 } else {
-                    // Nothing to do, explicitly stay in WAIT state
+#if ENABLE_DEEP_SLEEP_MODE
+                    // Battery mode: everything is drained and no read is in
+                    // flight - deep sleep until the next read deadline
+                    if (!g_readScheduler.hasInFlight() && !hasPublishWork() &&
+                        !otaService.isTransferActive() && !otaService.isReadyToReboot()) {
+                        unsigned long sleepMs = DeepSleepScheduler::computeSleepDurationMs(g_sensorPoints);
+                        if (sleepMs >= DEEP_SLEEP_MIN_SLEEP_MS) {
+                            DeepSleepScheduler::enterDeepSleep(sleepMs, ntpService); // Never returns
+                        }
+                    }
+#endif
+                    // Nothing to do (or a conversion is still in flight), stay in WAIT
                     transitionToState(currentState, WAIT, stateStartTime);
                 }
             }
@@ -482,6 +681,9 @@ void loop() {
         case RESTART:
             Serial.println("State: RESTART - Restarting controller...");
             delay(RESTART_DELAY_MS);
+            // Carry the current time across the restart (RTC-noinit) so the
+            // next boot timestamps immediately instead of blocking on NTP
+            ntpService.prepareForRestart();
             ESP.restart();
             break;
 
@@ -491,13 +693,15 @@ void loop() {
             break;
     }
 
-    // Periodically try to update NTP
+#if !ENABLE_DUAL_CORE_TASKS
+    // Periodically try to update NTP (NetworkTask owns this in dual-core mode)
     if (currentTime - lastNtpLoopUpdate >= NTP_LOOP_UPDATE_INTERVAL_MS) {
         if (ntpService.update()) {
             Serial.println("NTP update successful.");
         }
         lastNtpLoopUpdate = currentTime;
     }
+#endif
 
     // Periodically print debug queue status
     if (currentTime - lastDebugPrint >= DEBUG_QUEUE_INTERVAL_MS) {
@@ -506,5 +710,48 @@ void loop() {
         lastDebugPrint = currentTime;
     }
 
-    delay(MAIN_LOOP_DELAY_MS); 
+    // Flush a bounded slice of the async log ring (outside the FSM hot path)
+    Log::drain();
+
+    // Sample this loop iteration (latency histogram, state residency, heap)
+    perfTelemetry.loopTick(currentState);
+    perfTelemetry.recordQueueDepth(g_publishQueue.size());
+
+    // Publish the telemetry summary every few minutes
+    if (perfTelemetry.isTimeToPublish() && mqttService.isConnected() && ntpService.isTimeSet()) {
+        perfTelemetry.publish(mqttService, TELEMETRY_TOPIC, ntpService.getIso8601Cstr());
+    }
+
+    // Deadline-driven tickless idle: when the FSM has nothing queued, sleep
+    // until the earliest upcoming deadline - next sensor read, in-flight
+    // conversion ready time, NTP refresh, periodic checks, debug print -
+    // instead of polling on a fixed tick. Capped by TICKLESS_MAX_IDLE_MS so
+    // MQTT keepalive stays serviced; the busy path keeps the legacy tick.
+    unsigned long loopDelayMs = MAIN_LOOP_DELAY_MS;
+    if (currentState == WAIT && !hasPublishWork() && g_sensorsToReadQueue.empty()) {
+        DeadlineScheduler idleDeadlines;
+        unsigned long now = millis();
+        for (SensorPoint* sensor : g_sensorPoints) {
+            if (!sensor->isReadInFlight()) {
+                idleDeadlines.registerDelay(sensor->timeUntilNextReadMs(now));
+            }
+        }
+        if (g_readScheduler.hasInFlight()) {
+            idleDeadlines.registerDelay(g_readScheduler.earliestReadyRemainingMs(now));
+        }
+        idleDeadlines.registerDeadline(lastNtpLoopUpdate + NTP_LOOP_UPDATE_INTERVAL_MS, now);
+        idleDeadlines.registerDeadline(lastPeriodicCheck + PERIODIC_CHECKS_INTERVAL_MS, now);
+        idleDeadlines.registerDeadline(lastDebugPrint + DEBUG_QUEUE_INTERVAL_MS, now);
+#if ENABLE_DUAL_CORE_TASKS
+        loopDelayMs = idleDeadlines.nextDelayMs(TICKLESS_MAX_IDLE_MS);
+#else
+        // Single-core: OTA chunks only arrive when mqttService.loop() runs
+        // from this loop, so keep the legacy tick while a transfer is
+        // streaming; the full tickless cap applies otherwise (no command
+        // subscriptions on a sensor-only controller)
+        loopDelayMs = idleDeadlines.nextDelayMs(
+            otaService.isTransferActive() ? MAIN_LOOP_DELAY_MS : TICKLESS_MAX_IDLE_MS);
+#endif
+    }
+    delay(loopDelayMs);
 } 
\ No newline at end of file
@@ -7,10 +7,18 @@
 #include "actuators/ActuatorControlPoint.h" // For actuator management (updated path)
 #include "PublishData.h" // For publish queue
 #include "services/RestartReasonLogger.h" // For persistent restart reason logging
+#include "services/NetworkTask.h" // For dual-core network servicing (ENABLE_DUAL_CORE_TASKS)
+#include "services/PerfTelemetryService.h" // Loop latency / heap / queue telemetry
+#include "services/OtaUpdateService.h" // MQTT-driven delta OTA updates
+#include "services/WifiFastConnect.h" // Cached BSSID/channel/lease fast reconnect
 #include "utils/FsmUtils.h" // For FSM utility functions
+#include "utils/ThreadSafeCommandQueue.h" // Thread-safe "latest wins" command queue
+#include "utils/DeadlineScheduler.h" // Tickless idle: sleep until the next deadline
+#include "utils/ControllerRuntime.h" // Shared connectivity FSM (compile-time composition)
+#include "utils/Log.h" // Ring-buffered async logging
+#include "utils/TopicDispatchTable.h" // Hash-based topic -> actuator dispatch
 #include <map>
 #include <queue>
-#include <set>
 #include <vector>
 
 // Use FsmUtils namespace for cleaner function calls
@@ -20,16 +28,33 @@ using namespace FsmUtils;
 // GLOBAL COMMAND MANAGEMENT STRUCTURES (ADR-22 Section 2.3.1)
 // =============================================================================
 
+// Static actuator instances constructed from the autogen_config.h structs -
+// no heap, same pattern as the sensor registry on controller1/3
+ActuatorControlPoint g_humidifierActuator(HUMIDIFIER_CONFIG);
+ActuatorControlPoint g_heatingpadActuator(HEATINGPAD_CONFIG);
+ActuatorControlPoint g_lightActuator(LIGHT_CONFIG);
+ActuatorControlPoint g_ventfanActuator(VENTFAN_CONFIG);
+
 // Global vector to hold all actuator control points for this controller
 std::vector<ActuatorControlPoint*> g_actuatorPoints;
 
-// Topic-to-Actuator mapping for efficient MQTT command processing
-std::map<String, ActuatorControlPoint*> g_topicToActuatorMap;
-
-// Command Management for "Latest Wins" Logic
-std::map<ActuatorControlPoint*, String> g_pendingActuatorCommands;
-std::queue<ActuatorControlPoint*> g_actuatorsToProcessQueue;
-std::set<ActuatorControlPoint*> g_actuatorsInProcessQueueSet;
+// Topic dispatch table replacing the std::map<String, ActuatorControlPoint*>:
+// topic hashes are computed once during static init (the generator emits the
+// topics as struct fields, not macros, so they can't hash at compile time),
+// and inbound dispatch is a hash compare plus one confirming strcmp - no
+// String construction, no tree walk, no heap nodes (read-only, safe to share
+// with the network core)
+const TopicDispatchEntry g_topicDispatchTable[] = {
+    { TopicDispatch::hash(HUMIDIFIER_CONFIG.write_topic), HUMIDIFIER_CONFIG.write_topic, &g_humidifierActuator },
+    { TopicDispatch::hash(HEATINGPAD_CONFIG.write_topic), HEATINGPAD_CONFIG.write_topic, &g_heatingpadActuator },
+    { TopicDispatch::hash(LIGHT_CONFIG.write_topic),      LIGHT_CONFIG.write_topic,      &g_lightActuator },
+    { TopicDispatch::hash(VENTFAN_CONFIG.write_topic),    VENTFAN_CONFIG.write_topic,    &g_ventfanActuator },
+};
+const size_t g_topicDispatchCount = sizeof(g_topicDispatchTable) / sizeof(g_topicDispatchTable[0]);
+
+// Command Management for "Latest Wins" Logic - mutex-guarded so the MQTT
+// callback (core 0 in dual-core mode) and the FSM (core 1) can share it
+ThreadSafeCommandQueue g_actuatorCommandQueue;
 
 // Global publish queue for all outgoing MQTT messages
 std::queue<PublishData> g_publishQueue;
@@ -45,14 +70,8 @@ unsigned long stateStartTime = 0;  // For state timeouts
 // FSM STATE ATTEMPT COUNTERS
 // =============================================================================
 
-// WiFi connection attempts
-static unsigned int wifiAttempts = 0;
-
-// NTP sync attempts  
-static unsigned int ntpAttempts = 0;
-
-// Boot status publishing flag to prevent duplicates/publishes false restarts
-static bool bootStatusPublished = false;
+// Connectivity attempt ladders, warm-recovery flags and the boot-status
+// guard now live in the shared ControllerRuntime (declared below)
 
 // =============================================================================
 // EXISTING CONFIGURATION AND SERVICES
@@ -66,6 +85,33 @@ MqttService mqttService(MQTT_CLIENT_ID, MQTT_BROKER_ADDRESS, MQTT_BROKER_PORT,
 // Restart reason logger for persistent error logging (ADR-14, ADR-17)
 RestartReasonLogger restartLogger;
 
+// On-device performance telemetry (loop latency, heap, queue depths),
+// published periodically on the diagnostics topic below
+PerfTelemetryService perfTelemetry;
+
+// Fast WiFi reconnect: targeted connect from cached BSSID/channel/lease,
+// falling back to the full scan when the targeted attempt times out
+WifiFastConnect wifiFastConnect;
+
+// MQTT-driven OTA updates (delta or full image); the FSM restarts into a
+// staged image with the FIRMWARE_UPDATE reason
+OtaUpdateService otaService;
+#ifndef OTA_CONTROL_TOPIC
+#define OTA_CONTROL_TOPIC "mush/" DEVICE_ID "/commands/ota/write"
+#endif
+#ifndef TELEMETRY_TOPIC
+#define TELEMETRY_TOPIC "mush/" DEVICE_ID "/statuses/perf_telemetry"
+#endif
+#ifndef COMMAND_LATENCY_TOPIC
+#define COMMAND_LATENCY_TOPIC "mush/" DEVICE_ID "/statuses/command_latency"
+#endif
+
+#if ENABLE_DUAL_CORE_TASKS
+// Pinned FreeRTOS task on core 0 that services MQTT/NTP so the FSM on core 1
+// never waits behind network work (and vice versa)
+NetworkTask networkTask;
+#endif
+
 // How often to attempt NTP update in the loop (milliseconds)
 unsigned long lastNtpLoopUpdate = 0;
 
@@ -75,29 +121,14 @@ unsigned long lastDebugPrint = 0;
 void setupActuators() {
     Serial.println("Initializing Actuator Control Points...");
     
-    // Create ActuatorControlPoint instances using struct-based configuration (ADR-25)
-    ActuatorControlPoint* humidifier = new ActuatorControlPoint(HUMIDIFIER_CONFIG);
-    g_actuatorPoints.push_back(humidifier);
-    g_topicToActuatorMap[String(HUMIDIFIER_CONFIG.write_topic)] = humidifier;
-    Serial.println("Created humidifier actuator");
+    // Register the statically constructed actuator instances (ADR-25 configs)
+    g_actuatorPoints.push_back(&g_humidifierActuator);
+    g_actuatorPoints.push_back(&g_heatingpadActuator);
+    g_actuatorPoints.push_back(&g_lightActuator);
+    g_actuatorPoints.push_back(&g_ventfanActuator);
     
-    ActuatorControlPoint* heatingpad = new ActuatorControlPoint(HEATINGPAD_CONFIG);
-    g_actuatorPoints.push_back(heatingpad);
-    g_topicToActuatorMap[String(HEATINGPAD_CONFIG.write_topic)] = heatingpad;
-    Serial.println("Created heating pad actuator");
-    
-    ActuatorControlPoint* light = new ActuatorControlPoint(LIGHT_CONFIG);
-    g_actuatorPoints.push_back(light);
-    g_topicToActuatorMap[String(LIGHT_CONFIG.write_topic)] = light;
-    Serial.println("Created light actuator");
-    
-    ActuatorControlPoint* ventfan = new ActuatorControlPoint(VENTFAN_CONFIG);
-    g_actuatorPoints.push_back(ventfan);
-    g_topicToActuatorMap[String(VENTFAN_CONFIG.write_topic)] = ventfan;
-    Serial.println("Created vent fan actuator");
-    
-    Serial.print("Total actuators created: "); Serial.println(g_actuatorPoints.size());
-    Serial.print("Topic mappings created: "); Serial.println(g_topicToActuatorMap.size());
+    Serial.print("Total actuators registered: "); Serial.println(g_actuatorPoints.size());
+    Serial.print("Topic dispatch entries: "); Serial.println(g_topicDispatchCount);
     
     // Initialize all actuators (calls pinMode and sets initial hardware state)
     Serial.println("Initializing actuator hardware...");
@@ -122,18 +153,16 @@ void setupActuators() {
         Serial.println("'");
         
         // Populate command management structures
-        g_pendingActuatorCommands[actuator] = initialPayload;
-        g_actuatorsToProcessQueue.push(actuator);
-        g_actuatorsInProcessQueueSet.insert(actuator);
-        
-        Serial.print("Queued initial command '"); 
+        g_actuatorCommandQueue.queueCommand(actuator, initialPayload);
+
+        Serial.print("Queued initial command '");
         Serial.print(initialPayload);
         Serial.print("' for: ");
         Serial.println(actuator->getPointName());
     }
-    
+
     Serial.print("Total actuators queued for initial command processing: ");
-    Serial.println(g_actuatorsToProcessQueue.size());
+    Serial.println(g_actuatorCommandQueue.size());
     
     Serial.println("Actuator setup complete.");
 }
@@ -154,19 +183,37 @@ void setupSubscriptions() {
     Serial.println("MQTT subscriptions complete.");
 }
 
+// Compile-time controller composition for the shared runtime: actuator
+// controller, so MQTT connects re-subscribe to the actuator write topics
+struct C2RuntimeTraits {
+    static const char* lastRestartReasonTopic() { return TOPIC_C2_LastRestartReason_DATA; }
+    static const char* lastRestartReasonUuid() { return UUID_C2_LastRestartReason_DATA; }
+    static const char* otaControlTopic() { return OTA_CONTROL_TOPIC; }
+    static FsmState idleWorkState() { return PROCESS_COMMANDS; }
+    static void onMqttConnected() { setupSubscriptions(); }
+    static void queueForPublish(const PublishData& data) { g_publishQueue.push(data); }
+    // No flash buffer on the actuator controller - the legacy MQTT_TIMEOUT
+    // restart ladder applies
+    static bool bufferingWhileDisconnected() { return false; }
+};
+
+// Shared connectivity FSM (WiFi/NTP/MQTT ladders, warm recovery, boot status)
+ControllerRuntime<C2RuntimeTraits> g_runtime(ntpService, mqttService, restartLogger,
+                                             wifiFastConnect, otaService);
+
 // =============================================================================
 // DEBUG HELPER FUNCTIONS
 // =============================================================================
 
 void printCommandQueueStatus() {
     Serial.println("\n--- Command Queue Status ---");
-    Serial.print("Pending commands: "); Serial.println(g_pendingActuatorCommands.size());
-    Serial.print("Actuators to process: "); Serial.println(g_actuatorsToProcessQueue.size());
-    Serial.print("Actuators in process set: "); Serial.println(g_actuatorsInProcessQueueSet.size());
-    
-    if (!g_pendingActuatorCommands.empty()) {
+    Serial.print("Actuators to process: "); Serial.println(g_actuatorCommandQueue.size());
+
+    std::map<ActuatorControlPoint*, String> pendingSnapshot;
+    g_actuatorCommandQueue.snapshotPendingCommands(pendingSnapshot);
+    if (!pendingSnapshot.empty()) {
         Serial.println("Pending commands details:");
-        for (const auto& pair : g_pendingActuatorCommands) {
+        for (const auto& pair : pendingSnapshot) {
             Serial.print("  - ");
             Serial.print(pair.first->getPointName());
             Serial.print(": '");
@@ -198,6 +245,22 @@ bool isMqttConnected() {
 void checkPeriodicRepublishing() {
     // Check only for periodic republishing, timeout checking moved to WAIT state
     for (ActuatorControlPoint* actuator : g_actuatorPoints) {
+        // Queue readbacks for commands the fast path already executed at
+        // callback time (the FSM owns all publishing)
+        if (actuator->hasFastPathReadbackPending()) {
+            actuator->setFastPathReadbackPending(false);
+            String timestamp = ntpService.getFormattedISO8601Time();
+            PublishData fastPathReadback(
+                actuator->getReadbackTopic(),
+                actuator->getReadbackUUID(),
+                actuator->getLastSuccessfulPayload(),
+                timestamp,
+                actuator
+            );
+            g_publishQueue.push(fastPathReadback);
+            continue;
+        }
+
         // Check for periodic republishing
         if (actuator->isTimeToRepublish() && actuator->isLastStateSet()) {
             String timestamp = ntpService.getFormattedISO8601Time();
@@ -224,17 +287,25 @@ void setup() {
     // Debug: Print command queue status after setup
     printCommandQueueStatus();
 
+    // Load cached WiFi parameters for the targeted fast-connect path
+    wifiFastConnect.begin();
+
     Serial.println("Initializing MQTT Service...");
     mqttService.begin();// Sets server and callback, does not connect
+    mqttService.setOtaService(&otaService); // Route OTA messages to the updater
     
     // Set up command management for MQTT service
     mqttService.setCommandManagement(
-        &g_topicToActuatorMap,
-        &g_pendingActuatorCommands,
-        &g_actuatorsToProcessQueue,
-        &g_actuatorsInProcessQueueSet
+        g_topicDispatchTable, g_topicDispatchCount,
+        &g_actuatorCommandQueue
     );
 
+#if ENABLE_DUAL_CORE_TASKS
+    // Dual-core mode: MQTT/NTP servicing runs pinned to core 0, the FSM below
+    // keeps core 1. MqttService's internal mutex makes the split safe.
+    networkTask.begin(mqttService, ntpService);
+#endif
+
     Serial.println("Setup complete. Entering main FSM loop...");
     Serial.println("FSM will handle: WiFi -> NTP -> MQTT -> Boot Status -> Normal Operation");
     lastNtpLoopUpdate = millis(); // Initialize for loop updates
@@ -245,147 +316,33 @@ void setup() {
 void loop() {
     unsigned long currentTime = millis();
 
-    mqttService.loop(); // Process MQTT messages and maintain connection
+#if !ENABLE_DUAL_CORE_TASKS
+    mqttService.loop(); // Process MQTT messages and maintain connection (NetworkTask owns this in dual-core mode)
+#endif
 
     // Main FSM Logic
     switch (currentState) {
         case CONNECT_WIFI:
-            // Check if WiFi is already connected
-            if (WiFi.status() == WL_CONNECTED) {
-                Serial.println("WiFi connected successfully!");
-                Serial.print("IP Address: ");
-                Serial.println(WiFi.localIP());
-                resetRetries(wifiAttempts, "WiFi");
-                transitionToState(currentState, SYNC_NTP, stateStartTime, true); // New operation - reset timer
-                break;
-            }
-            
-            // Check if this is a new attempt or timeout
-            if (wifiAttempts == 0 || checkTimeout(stateStartTime, WIFI_ATTEMPT_TIMEOUT_MS)) {
-                if (checkAndIncrementRetries(wifiAttempts, MAX_WIFI_ATTEMPTS, "WiFi")) {
-                    handleRestartWithReason(currentState, WIFI_TIMEOUT, restartLogger, ntpService);
-                    break;
-                }
-                
-                // Start new WiFi attempt
-                Serial.print(" - Connecting to: ");
-                Serial.println(WIFI_SSID);
-                
-                WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-                stateStartTime = currentTime; // Manual reset for new attempt timer
-            } else {
-                // Still waiting for current attempt
-                Serial.print(".");
-            }
+            g_runtime.handleConnectWifi(currentState, stateStartTime, currentTime);
             break;
 
         case SYNC_NTP:
-            // Initialize NTP service if this is the first attempt
-            if (ntpAttempts == 0) {
-                Serial.println("Initializing NTP Service...");
-                ntpService.begin();
-                ntpAttempts = 1;
-                stateStartTime = currentTime;
-            }
-            
-            // Try to update/sync NTP
-            ntpService.update();
-            
-            // Check if NTP is now synchronized
-            if (ntpService.isTimeSet()) {
-                Serial.println("NTP sync successful!");
-                Serial.print("Current UTC Time: ");
-                Serial.println(ntpService.getFormattedISO8601Time());
-                Serial.print("Current Epoch Time: ");
-                Serial.println(ntpService.getEpochTime());
-                resetRetries(ntpAttempts, "NTP");
-                transitionToState(currentState, CONNECT_MQTT, stateStartTime, true); // New operation - reset timer
-                break;
-            }
-            
-            // Check for timeout on current attempt
-            if (checkTimeout(stateStartTime, NTP_ATTEMPT_TIMEOUT_MS)) {
-                if (checkAndIncrementRetries(ntpAttempts, MAX_NTP_ATTEMPTS, "NTP")) {
-                    handleRestartWithReason(currentState, NTP_TIMEOUT, restartLogger, ntpService);
-                    break;
-                }
-                
-                // Start new NTP attempt
-                Serial.println(" - Retrying...");
-                stateStartTime = currentTime; // Manual reset for new attempt timer
-            } else {
-                // Still waiting for current attempt
-                Serial.print("n"); // NTP attempt indicator
-            }
+            g_runtime.handleSyncNtp(currentState, stateStartTime, currentTime);
             break;
 
         case CONNECT_MQTT:
-            if (mqttService.connectBroker()) {
-                Serial.println("MQTT connected successfully!");
-                setupSubscriptions(); // Subscribe to all actuator WRITE topics
-                
-                // Only publish boot status if we haven't already
-                if (!bootStatusPublished) {
-                    transitionToState(currentState, PUBLISH_BOOT_STATUS, stateStartTime);
-                } else {
-                    transitionToState(currentState, PROCESS_COMMANDS, stateStartTime);
-                }
-            } else {
-                Serial.println("MQTT connection failed, retrying...");
-                
-                // Check for MQTT timeout (using constant from autogen_config.h)
-                if (checkTimeout(stateStartTime, MQTT_CONNECT_TIMEOUT_MS)) {
-                    handleRestartWithReason(currentState, MQTT_TIMEOUT, restartLogger, ntpService);
-                } else {
-                    // Stay in this state, keep timer - don't spam transitions  
-                    transitionToState(currentState, CONNECT_MQTT, stateStartTime); // Stay in this state, keep timer
-                    delay(MQTT_RETRY_DELAY_MS); // Retry delay from autogen_config.h
-                }
-            }
+            g_runtime.handleConnectMqtt(currentState, stateStartTime, currentTime);
             break;
 
-        case PUBLISH_BOOT_STATUS: {
-            // Always publish a restart reason - default to unknown if none stored
-            PublishData bootStatus;
-            if (restartLogger.hasStoredRestartReason()) {
-                Serial.println("Found stored restart reason, creating publish data...");
-                bootStatus = restartLogger.createPublishData(
-                    ntpService,
-                    TOPIC_C2_LastRestartReason_DATA,
-                    UUID_C2_LastRestartReason_DATA
-                );
-            } else {
-                Serial.println("No stored restart reason found, defaulting to unknown_reset");
-                // Create PublishData for unknown restart reason
-                String timestamp = ntpService.getFormattedISO8601Time();
-                String reasonString = RestartReasonLogger::restartReasonToString(UNKNOWN_RESET);
-                bootStatus = PublishData(
-                    TOPIC_C2_LastRestartReason_DATA,
-                    UUID_C2_LastRestartReason_DATA,
-                    reasonString,
-                    timestamp
-                );
-            }
-            
-            g_publishQueue.push(bootStatus);
-            Serial.println("Restart reason queued for publishing");
-            
-            // Mark boot status as published and transition to normal operation
-            bootStatusPublished = true;
-            transitionToState(currentState, PROCESS_COMMANDS, stateStartTime);
+        case PUBLISH_BOOT_STATUS:
+            g_runtime.handlePublishBootStatus(currentState, stateStartTime);
             break;
-        }
 
-        case PROCESS_COMMANDS:
-            if (!g_actuatorsToProcessQueue.empty()) {
-                // Process one command from the queue
-                ActuatorControlPoint* actuatorToProcess = g_actuatorsToProcessQueue.front();
-                g_actuatorsToProcessQueue.pop();
-                g_actuatorsInProcessQueueSet.erase(actuatorToProcess);
-                
-                // Get the latest command for this actuator
-                String latestPayload = g_pendingActuatorCommands[actuatorToProcess];
-                
+        case PROCESS_COMMANDS: {
+            // Atomically dequeue the next actuator and its latest pending command
+            ActuatorControlPoint* actuatorToProcess = nullptr;
+            String latestPayload;
+            if (g_actuatorCommandQueue.dequeueCommand(actuatorToProcess, latestPayload)) {
                 Serial.print("Processing command '");
                 Serial.print(latestPayload);
                 Serial.print("' for: ");
@@ -395,6 +352,7 @@ void loop() {
                 if (actuatorToProcess->executeDeviceCommand(latestPayload)) {
                     // Command executed successfully - store the successful payload and create readback
                     actuatorToProcess->setLastSuccessfulPayload(latestPayload);
+                    actuatorToProcess->recordCommandExecuted(); // Receipt->digitalWrite latency
                     
                     String timestamp = ntpService.getFormattedISO8601Time();
                     
@@ -418,10 +376,9 @@ void loop() {
                     Serial.println(latestPayload);
                     // Could add error handling/logging here in future
                 }
-                
-                // Remove the processed command (whether successful or not)
-                g_pendingActuatorCommands.erase(actuatorToProcess);
-                
+
+                // Note: dequeueCommand() already removed the pending command
+
                 // Transition to publish the readback (if any was created)
                 transitionToState(currentState, PUBLISH_DATA, stateStartTime);
             } else {
@@ -429,39 +386,45 @@ void loop() {
                 transitionToState(currentState, WAIT, stateStartTime);
             }
             break;
+        }
 
         case PUBLISH_DATA:
             // Check MQTT connection first - if not connected, transition to reconnect
             if (!mqttService.isConnected()) {
-                Serial.println("MQTT not connected in PUBLISH_DATA state - transitioning to CONNECT_MQTT");
+                LOG_WARN("MQTT not connected in PUBLISH_DATA state - transitioning to CONNECT_MQTT");
                 transitionToState(currentState, CONNECT_MQTT, stateStartTime);
                 break;
             }
             
             if (!g_publishQueue.empty()) {
-                PublishData item = g_publishQueue.front();
-                g_publishQueue.pop();
-                
-                Serial.print("Publishing to ");
-                Serial.print(item.topic);
-                Serial.print(": ");
-                Serial.print(item.serializedValue);
-                Serial.print(" at ");
-                Serial.println(item.timestampIsoUtc);
-                
-                // Publish via MQTT using publishJson with the raw value
-                if (mqttService.publishJson(item.topic, item.timestampIsoUtc, item.uuid, item.serializedValue)) {
-                    Serial.println("Publish successful!");
-                    
-                    // Update the source actuator's last publish time
-                    if (item.sourceActuator != nullptr) {
-                        item.sourceActuator->setLastPublishTimeMillis(currentTime);
+                // Batch drain: keep publishing until the queue is empty or the
+                // time budget is spent - actuator readbacks reach the broker
+                // in single-digit milliseconds instead of N loop periods
+                unsigned long drainStart = millis();
+                while (!g_publishQueue.empty() &&
+                       (millis() - drainStart) < PUBLISH_DRAIN_BUDGET_MS &&
+                       mqttService.isConnected()) {
+                    PublishData item = g_publishQueue.front();
+                    g_publishQueue.pop();
+
+                    LOG_DEBUG("Publishing to %s: %s at %s", item.topic,
+                              item.serializedValue.c_str(), item.timestampIsoUtc.c_str());
+
+                    // Publish via MQTT using the zero-allocation publishJson path
+                    if (mqttService.publishJson(item.topic, item.timestampIsoUtc.c_str(), item.uuid, item.serializedValue.c_str())) {
+                        LOG_DEBUG("Publish successful!");
+
+                        // Update the source actuator's last publish time
+                        if (item.sourceActuator != nullptr) {
+                            item.sourceActuator->setLastPublishTimeMillis(millis());
+                        }
+                    } else {
+                        LOG_WARN("Publish failed!");
+                        // For now the item is dropped; stop draining this pass
+                        break;
                     }
-                } else {
-                    Serial.println("Publish failed!");
-                    // For now, just continue - could implement retry logic later
                 }
-                
+
                 // Always transition to WAIT to let FSM decide what's next
                 transitionToState(currentState, WAIT, stateStartTime);
             } else {
@@ -478,6 +441,15 @@ void loop() {
                 transitionToState(currentState, RESTART, stateStartTime);
                 break;
             }
+
+            // Restart into a staged OTA update (FIRMWARE_UPDATE reason keeps
+            // the restart history honest and pairs with bootloader rollback)
+            if (otaService.isReadyToReboot()) {
+                Serial.println("Staged OTA update ready - restarting into new image");
+                restartLogger.storeRestartReason(FIRMWARE_UPDATE, ntpService);
+                transitionToState(currentState, RESTART, stateStartTime);
+                break;
+            }
             
             // Check connectivity (highest priority after timeout checks)
             if (!isWiFiConnected()) {
@@ -486,7 +458,7 @@ void loop() {
                 transitionToState(currentState, CONNECT_MQTT, stateStartTime);
             }
             // Check for work to do
-            else if (!g_actuatorsToProcessQueue.empty()) {
+            else if (!g_actuatorCommandQueue.empty()) {
                 transitionToState(currentState, PROCESS_COMMANDS, stateStartTime);
             } else if (!g_publishQueue.empty()) {
                 transitionToState(currentState, PUBLISH_DATA, stateStartTime);
@@ -501,6 +473,9 @@ void loop() {
         case RESTART:
             Serial.println("State: RESTART - Restarting controller...");
             delay(RESTART_DELAY_MS);
+            // Carry the current time across the restart (RTC-noinit) so the
+            // next boot timestamps immediately instead of blocking on NTP
+            ntpService.prepareForRestart();
             ESP.restart();
             break;
 
@@ -510,13 +485,15 @@ void loop() {
             break;
     }
 
-    // Periodically try to update NTP
+#if !ENABLE_DUAL_CORE_TASKS
+    // Periodically try to update NTP (NetworkTask owns this in dual-core mode)
     if (currentTime - lastNtpLoopUpdate >= NTP_LOOP_UPDATE_INTERVAL_MS) {
         if (ntpService.update()) {
             Serial.println("NTP update successful.");
         }
         lastNtpLoopUpdate = currentTime;
     }
+#endif
 
     // Periodically print debug queue status
     if (currentTime - lastDebugPrint >= DEBUG_QUEUE_INTERVAL_MS) {
@@ -525,5 +502,74 @@ void loop() {
         lastDebugPrint = currentTime;
     }
 
-    delay(MAIN_LOOP_DELAY_MS); 
+    // Flush a bounded slice of the async log ring (outside the FSM hot path)
+    Log::drain();
+
+    // Sample this loop iteration (latency histogram, state residency, heap)
+    perfTelemetry.loopTick(currentState);
+    perfTelemetry.recordQueueDepth(g_publishQueue.size());
+
+    // Publish the telemetry summary every few minutes, with the actuator
+    // command-latency distribution (receipt -> digitalWrite) alongside it
+    if (perfTelemetry.isTimeToPublish() && mqttService.isConnected() && ntpService.isTimeSet()) {
+        perfTelemetry.publish(mqttService, TELEMETRY_TOPIC, ntpService.getIso8601Cstr());
+
+        char latencyPayload[448]; // Headroom for 4 actuators at max counter widths
+        // loop_gap_max_us upper-bounds how long an inbound command waited
+        // before its callback fired (single-core: the MQTT loop-servicing
+        // gap) - without it the per-actuator numbers could look sub-10ms
+        // while the real wire-to-actuation latency was dominated by the gap
+        int offset = snprintf(latencyPayload, sizeof(latencyPayload),
+                              "{\"timestamp_utc\":\"%s\",\"loop_gap_max_us\":%lu,\"actuators\":[",
+                              ntpService.getIso8601Cstr(),
+                              (unsigned long)perfTelemetry.loopMaxUs());
+        bool payloadOk = (offset > 0 && (size_t)offset < sizeof(latencyPayload));
+        for (size_t i = 0; payloadOk && i < g_actuatorPoints.size(); i++) {
+            ActuatorControlPoint* actuator = g_actuatorPoints[i];
+            int written = snprintf(latencyPayload + offset, sizeof(latencyPayload) - offset,
+                                   "%s{\"name\":\"%s\",\"count\":%lu,\"avg_us\":%lu,\"max_us\":%lu}",
+                                   (i == 0) ? "" : ",",
+                                   actuator->getPointName(),
+                                   (unsigned long)actuator->getCommandLatencyCount(),
+                                   (unsigned long)actuator->getCommandLatencyAvgUs(),
+                                   (unsigned long)actuator->getCommandLatencyMaxUs());
+            payloadOk = (written > 0 && (size_t)written < sizeof(latencyPayload) - offset);
+            offset += written;
+        }
+        if (payloadOk && (size_t)offset < sizeof(latencyPayload) - 2) {
+            latencyPayload[offset++] = ']';
+            latencyPayload[offset++] = '}';
+            latencyPayload[offset] = '\0';
+            mqttService.publishRaw(COMMAND_LATENCY_TOPIC, latencyPayload);
+        }
+    }
+
+    // Deadline-driven tickless idle: when no commands or publishes are
+    // pending, sleep until the earliest upcoming deadline - next actuator
+    // readback republish, NTP refresh, debug print - instead of polling on a
+    // fixed tick. Capped by TICKLESS_MAX_IDLE_MS so inbound commands and
+    // MQTT keepalive stay responsive; the busy path keeps the legacy tick.
+    unsigned long loopDelayMs = MAIN_LOOP_DELAY_MS;
+    if (currentState == WAIT && g_actuatorCommandQueue.empty() && g_publishQueue.empty()) {
+        DeadlineScheduler idleDeadlines;
+        unsigned long now = millis();
+        for (ActuatorControlPoint* actuator : g_actuatorPoints) {
+            idleDeadlines.registerDeadline(
+                actuator->getLastPublishTimeMillis() + actuator->getOutputRepublishFrequencyMillis(), now);
+        }
+        idleDeadlines.registerDeadline(lastNtpLoopUpdate + NTP_LOOP_UPDATE_INTERVAL_MS, now);
+        idleDeadlines.registerDeadline(lastDebugPrint + DEBUG_QUEUE_INTERVAL_MS, now);
+#if ENABLE_DUAL_CORE_TASKS
+        // NetworkTask services MQTT on core 0, so the FSM core can sleep to
+        // the full tickless cap without touching command latency
+        loopDelayMs = idleDeadlines.nextDelayMs(TICKLESS_MAX_IDLE_MS);
+#else
+        // Single-core: inbound commands are only parsed when
+        // mqttService.loop() runs from this loop, so the idle sleep must
+        // stay at the legacy tick or command latency balloons to the
+        // tickless cap (vs. user-026's sub-10ms target)
+        loopDelayMs = idleDeadlines.nextDelayMs(MAIN_LOOP_DELAY_MS);
+#endif
+    }
+    delay(loopDelayMs);
 } 
\ No newline at end of file
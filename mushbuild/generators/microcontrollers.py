@@ -213,8 +213,8 @@ class MicrocontrollerConfigGenerator:
         # emit topic/uuid pairs
         lines.extend(self._emit_topic_uuid_pair("co2", sensor.co2_uuid, tr, trailing_comma=True))
         lines.extend(self._emit_topic_uuid_pair("temp", sensor.temp_uuid, tr, trailing_comma=True))
-        pair = self._emit_topic_uuid_pair("humidity", sensor.humidity_uuid, tr, trailing_comma=False)
-        lines.extend(pair)
+        lines.extend(self._emit_topic_uuid_pair("humidity", sensor.humidity_uuid, tr, trailing_comma=True))
+        lines.extend(self._emit_extended_sensor_fields(sensor, include_i2c_clock=True))
         lines.append("};")
         lines.append("")
         return lines
@@ -227,8 +227,8 @@ class MicrocontrollerConfigGenerator:
         lines.append(f"    .address = 0x{sensor.address:02X},")
         lines.append(f"    .c_to_f = {self._format_bool(sensor.c_to_f)},")
         lines.extend(self._emit_topic_uuid_pair("temp", sensor.temperature_uuid, tr, trailing_comma=True))
-        pair = self._emit_topic_uuid_pair("humidity", sensor.humidity_uuid, tr, trailing_comma=False)
-        lines.extend(pair)
+        lines.extend(self._emit_topic_uuid_pair("humidity", sensor.humidity_uuid, tr, trailing_comma=True))
+        lines.extend(self._emit_extended_sensor_fields(sensor, include_i2c_clock=True))
         lines.append("};")
         lines.append("")
         return lines
@@ -242,8 +242,8 @@ class MicrocontrollerConfigGenerator:
         lines.append(f"    .c_to_f = {self._format_bool(sensor.c_to_f)},")
         lines.extend(self._emit_topic_uuid_pair("temp", sensor.temperature_uuid, tr, trailing_comma=True))
         lines.extend(self._emit_topic_uuid_pair("humidity", sensor.humidity_uuid, tr, trailing_comma=True))
-        pair = self._emit_topic_uuid_pair("pressure", sensor.pressure_uuid, tr, trailing_comma=False)
-        lines.extend(pair)
+        lines.extend(self._emit_topic_uuid_pair("pressure", sensor.pressure_uuid, tr, trailing_comma=True))
+        lines.extend(self._emit_extended_sensor_fields(sensor, include_i2c_clock=True))
         lines.append("};")
         lines.append("")
         return lines
@@ -256,8 +256,8 @@ class MicrocontrollerConfigGenerator:
         lines.append(f"    .pin = {sensor.pin},")
         lines.append(f"    .c_to_f = {self._format_bool(sensor.c_to_f)},")
         lines.extend(self._emit_topic_uuid_pair("temp", sensor.temperature_uuid, tr, trailing_comma=True))
-        pair = self._emit_topic_uuid_pair("humidity", sensor.humidity_uuid, tr, trailing_comma=False)
-        lines.extend(pair)
+        lines.extend(self._emit_topic_uuid_pair("humidity", sensor.humidity_uuid, tr, trailing_comma=True))
+        lines.extend(self._emit_extended_sensor_fields(sensor))
         lines.append("};")
         lines.append("")
         return lines
@@ -270,8 +270,8 @@ class MicrocontrollerConfigGenerator:
         lines.append(f"    .pin = {sensor.pin},")
         lines.append(f"    .resolution_bits = {sensor.resolution_bits},              // {sensor.resolution_bits}-bit resolution = 0.25°C precision, 187.5ms conversion")
         lines.append(f"    .c_to_f = {self._format_bool(sensor.c_to_f)},")
-        pair = self._emit_topic_uuid_pair("temp", sensor.temperature_uuid, tr, trailing_comma=False)
-        lines.extend(pair)
+        lines.extend(self._emit_topic_uuid_pair("temp", sensor.temperature_uuid, tr, trailing_comma=True))
+        lines.extend(self._emit_extended_sensor_fields(sensor))
         lines.append("};")
         lines.append("")
         return lines
@@ -292,7 +292,9 @@ class MicrocontrollerConfigGenerator:
         lines.append(f'    .readback_uuid = "{actuator.readback_uuid}",')
         # timing
         lines.append("    .republish_frequency_ms = OUTPUT_REPUBLISH_FREQUENCY_MS,")
-        lines.append("    .max_time_no_publish_ms = MAX_TIME_NO_PUBLISH_MS")
+        lines.append("    .max_time_no_publish_ms = MAX_TIME_NO_PUBLISH_MS,")
+        lines.append(f"    .critical_fast_path = {1 if actuator.critical_fast_path else 0},")
+        lines.append(f"    .cov_heartbeat_ms = {actuator.cov_heartbeat_ms}")
         lines.append("};")
         lines.append("")
         return lines
@@ -304,6 +306,19 @@ class MicrocontrollerConfigGenerator:
         uuid_line = f'    .{label}_uuid = "{uuid}"' + ("," if trailing_comma else "")
         return [topic_line, uuid_line]
 
+    def _emit_extended_sensor_fields(self, sensor, include_i2c_clock: bool = False) -> list[str]:
+        """Emit the trailing performance/behavior fields shared by all sensor structs.
+        Order must match the C struct declaration order (designated initializers)."""
+        lines: list[str] = []
+        lines.append(f"    .sample_interval_ms = {sensor.sample_interval_ms},")
+        lines.append(f"    .cov_deadband = {self._format_float_literal(sensor.cov_deadband)},")
+        if include_i2c_clock:
+            lines.append(f"    .cov_heartbeat_ms = {sensor.cov_heartbeat_ms},")
+            lines.append(f"    .i2c_max_clock_hz = {sensor.i2c_max_clock_hz}")
+        else:
+            lines.append(f"    .cov_heartbeat_ms = {sensor.cov_heartbeat_ms}")
+        return lines
+
     def _emit_common_sensor_fields(self, sensor) -> list[str]:
         lines: list[str] = []
         lines.append(f'    .point_name = "{sensor.point_name}",')
@@ -315,6 +330,13 @@ class MicrocontrollerConfigGenerator:
     def _format_bool(self, value: bool) -> str:
         return "true" if value else "false"
 
+    def _format_float_literal(self, value: float) -> str:
+        """Format a float as a C literal (0 -> 0.0f, 0.5 -> 0.5f)."""
+        text = f"{value:g}"
+        if "." not in text and "e" not in text and "E" not in text:
+            text += ".0"
+        return text + "f"
+
     def _format_hex(self, value: int) -> str:
         return f"0x{value:02X}"
 
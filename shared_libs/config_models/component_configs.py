@@ -341,6 +341,10 @@ class SHT85SensorConfig(BaseModel):
     temperature_uuid: PointUUID = Field(..., description="Temperature point UUID")
     humidity_uuid: PointUUID = Field(..., description="Humidity point UUID")
     c_to_f: bool = Field(True, description="Convert Celsius to Fahrenheit")
+    sample_interval_ms: int = Field(0, description="Oversampling cadence between publishes in ms (0 = disabled, publish raw reads)")
+    cov_deadband: float = Field(0.0, description="Change-of-value deadband (0 = publish every interval)")
+    cov_heartbeat_ms: int = Field(0, description="CoV heartbeat republish in ms (0 = 10x publish interval)")
+    i2c_max_clock_hz: int = Field(0, description="Device max I2C clock in Hz (0 = conservative 100kHz default)")
     model_config = {"extra": "forbid"}
 
 class BME280SensorConfig(BaseModel):
@@ -352,6 +356,10 @@ class BME280SensorConfig(BaseModel):
     humidity_uuid: PointUUID = Field(..., description="Humidity point UUID")
     pressure_uuid: PointUUID = Field(..., description="Pressure point UUID")
     c_to_f: bool = Field(True, description="Convert Celsius to Fahrenheit")
+    sample_interval_ms: int = Field(0, description="Oversampling cadence between publishes in ms (0 = disabled, publish raw reads)")
+    cov_deadband: float = Field(0.0, description="Change-of-value deadband (0 = publish every interval)")
+    cov_heartbeat_ms: int = Field(0, description="CoV heartbeat republish in ms (0 = 10x publish interval)")
+    i2c_max_clock_hz: int = Field(0, description="Device max I2C clock in Hz (0 = conservative 100kHz default)")
     model_config = {"extra": "forbid"}
 
 class DHT22SensorConfig(BaseModel):
@@ -362,6 +370,9 @@ class DHT22SensorConfig(BaseModel):
     temperature_uuid: PointUUID = Field(..., description="Temperature point UUID")
     humidity_uuid: PointUUID = Field(..., description="Humidity point UUID")
     c_to_f: bool = Field(True, description="Convert Celsius to Fahrenheit")
+    sample_interval_ms: int = Field(0, description="Oversampling cadence between publishes in ms (0 = disabled, publish raw reads)")
+    cov_deadband: float = Field(0.0, description="Change-of-value deadband (0 = publish every interval)")
+    cov_heartbeat_ms: int = Field(0, description="CoV heartbeat republish in ms (0 = 10x publish interval)")
     model_config = {"extra": "forbid"}
 
 class DS18B20SensorConfig(BaseModel):
@@ -372,6 +383,9 @@ class DS18B20SensorConfig(BaseModel):
     temperature_uuid: PointUUID = Field(..., description="Temperature point UUID")
     resolution_bits: int = Field(10, description="DS18B20 resolution in bits")
     c_to_f: bool = Field(True, description="Convert Celsius to Fahrenheit")
+    sample_interval_ms: int = Field(0, description="Oversampling cadence between publishes in ms (0 = disabled, publish raw reads)")
+    cov_deadband: float = Field(0.0, description="Change-of-value deadband (0 = publish every interval)")
+    cov_heartbeat_ms: int = Field(0, description="CoV heartbeat republish in ms (0 = 10x publish interval)")
     model_config = {"extra": "forbid"}
 
 # FSM Configuration
@@ -443,6 +457,10 @@ class SCD4XSensorConfig(BaseModel):
     humidity_topic: str = Field(..., description="MQTT topic for humidity data")
     humidity_uuid: PointUUID = Field(..., description="Humidity point UUID")
     c_to_f: bool = Field(True, description="Convert Celsius to Fahrenheit")
+    sample_interval_ms: int = Field(0, description="Oversampling cadence between publishes in ms (0 = disabled, publish raw reads)")
+    cov_deadband: float = Field(0.0, description="Change-of-value deadband (0 = publish every interval)")
+    cov_heartbeat_ms: int = Field(0, description="CoV heartbeat republish in ms (0 = 10x publish interval)")
+    i2c_max_clock_hz: int = Field(0, description="Device max I2C clock in Hz (0 = conservative 100kHz default)")
     model_config = {"extra": "forbid"}
 
 # Actuator configuration
@@ -456,6 +474,8 @@ class ActuatorConfig(BaseModel):
     readback_uuid: PointUUID = Field(..., description="Readback point UUID")
     pin_mode: Literal["OUTPUT"] = Field("OUTPUT", description="Pin mode")
     initial_state: Literal["LOW", "HIGH"] = Field("LOW", description="Initial pin state")
+    critical_fast_path: bool = Field(False, description="Execute validated on/off commands at MQTT callback time (sub-ms actuation for critical actuators)")
+    cov_heartbeat_ms: int = Field(0, description="CoV mode: republish unchanged readback only this often in ms (0 = legacy republish frequency)")
     model_config = {"extra": "forbid"}
 
 # MQTT configuration with client_id
@@ -524,6 +544,33 @@ class MicrocontrollerConfig(BaseModel):
 
     model_config = {"extra": "forbid"}
 
+    @model_validator(mode='after')
+    def _validate_cov_heartbeats(self) -> "MicrocontrollerConfig":
+        """CoV heartbeats must land well inside the no-publish watchdog window,
+        or enabling a deadband guarantees a NOPUBLISH_TIMEOUT restart loop."""
+        watchdog_ms = self.timing.max_time_no_publish_ms
+        if not watchdog_ms:
+            return self
+
+        ceiling = watchdog_ms // 2
+        sensor_lists = [self.i2c_sensors or [], self.dht_sensors or [], self.onewire_sensors or []]
+        for sensors in sensor_lists:
+            for sensor in sensors:
+                if sensor.cov_heartbeat_ms and sensor.cov_heartbeat_ms > ceiling:
+                    raise ValueError(
+                        f"{sensor.instance_name}: cov_heartbeat_ms ({sensor.cov_heartbeat_ms}) must be "
+                        f"<= half of timing.max_time_no_publish_ms ({watchdog_ms}) to stay clear of the "
+                        f"no-publish watchdog"
+                    )
+        for actuator in self.actuators or []:
+            if actuator.cov_heartbeat_ms and actuator.cov_heartbeat_ms > ceiling:
+                raise ValueError(
+                    f"{actuator.instance_name}: cov_heartbeat_ms ({actuator.cov_heartbeat_ms}) must be "
+                    f"<= half of timing.max_time_no_publish_ms ({watchdog_ms}) to stay clear of the "
+                    f"no-publish watchdog"
+                )
+        return self
+
     @model_validator(mode='before')
     @classmethod
     def ensure_required_sections(cls, data: Any, info: ValidationInfo):